@@ -1,4 +1,5 @@
 #include <vector>
+#include <cassert>
 
 template<typename T, int FAC_MAX>
 struct Comb {
@@ -42,4 +43,210 @@ struct Comb {
     T factorial(int n) {
         return nPr(n, n);
     }
+    /**
+     * @brief n が表に収まらない場合も含めて nCr を求める
+     * @note 法 p が FAC_MAX 以下なら Lucas の定理 O(log_p n)、そうでなく n が FAC_MAX 以上なら下降階乗 O(min(r, n - r)) で求める
+     */
+    T nCr_large(long long n, long long r) {
+        if (r < 0 || n < r) return T(0);
+        long long p = (long long)T(-1).val() + 1;
+        if (p > FAC_MAX && n < FAC_MAX) return nCr(n, r);
+        if (p <= FAC_MAX) {
+            T res(1);
+            while (n > 0 && res != T(0)) {
+                int ni = n % p, ri = r % p;
+                if (ni < ri) return T(0);
+                res *= fac[ni] / (fac[ri] * fac[ni - ri]);
+                n /= p;
+                r /= p;
+            }
+            return res;
+        }
+        r = std::min(r, n - r);
+        assert(r < FAC_MAX);
+        T res(1);
+        for (long long i = 0; i < r; i++) {
+            res *= T(n - i);
+        }
+        return res * ifac[r];
+    }
+};
+
+/**
+ * @brief 任意の法での二項係数 (法を素数冪に分解して Granville の定理で求め、中国剰余定理で復元する)
+ * @note 前計算 O(法の素数冪の和)、クエリ O(Σ log_p n)
+ */
+struct Binomial_Mod {
+    struct Prime_Power {
+        long long p, q, pq;
+        std::vector<long long> fac, ifac;
+    };
+    long long mod;
+    std::vector<Prime_Power> pps;
+    /**
+     * @brief a * b mod m
+     */
+    static long long mul_mod(long long a, long long b, long long m) {
+        return (long long)((__int128)a * b % m);
+    }
+    /**
+     * @brief 逆元 (a と m は互いに素)
+     */
+    static long long inv_mod(long long a, long long m) {
+        long long b = m, u = 1, v = 0;
+        while (b) {
+            long long t = a / b;
+            a -= t * b;
+            std::swap(a, b);
+            u -= t * v;
+            std::swap(u, v);
+        }
+        u %= m;
+        return u < 0 ? u + m : u;
+    }
+    /**
+     * @brief Construct a new Binomial_Mod object
+     *
+     * @param m 法 (各素数冪の大きさの表を作るので、素数冪は小さいこと)
+     */
+    Binomial_Mod(long long m) : mod(m) {
+        for (long long p = 2; p * p <= m; p++) {
+            if (m % p != 0) continue;
+            Prime_Power pp{p, 0, 1, {}, {}};
+            while (m % p == 0) {
+                m /= p;
+                pp.q++;
+                pp.pq *= p;
+            }
+            pps.push_back(pp);
+        }
+        if (m != 1) pps.push_back(Prime_Power{m, 1, m, {}, {}});
+        for (auto &pp : pps) {
+            pp.fac.assign(pp.pq, 1);
+            pp.ifac.assign(pp.pq, 1);
+            for (long long i = 1; i < pp.pq; i++) {
+                pp.fac[i] = (i % pp.p == 0 ? pp.fac[i - 1] : mul_mod(pp.fac[i - 1], i, pp.pq));
+            }
+            pp.ifac[pp.pq - 1] = inv_mod(pp.fac[pp.pq - 1], pp.pq);
+            for (long long i = pp.pq - 1; i > 0; i--) {
+                pp.ifac[i - 1] = (i % pp.p == 0 ? pp.ifac[i] : mul_mod(pp.ifac[i], i, pp.pq));
+            }
+        }
+    }
+    /**
+     * @brief 法 p^q での nCr (Granville の定理)
+     */
+    static long long nCr_prime_power(const Prime_Power &pp, long long n, long long r) {
+        long long s = n - r, e0 = 0, eq = 0, res = 1;
+        for (int i = 0; n > 0; ) {
+            res = mul_mod(res, pp.fac[n % pp.pq], pp.pq);
+            res = mul_mod(res, pp.ifac[r % pp.pq], pp.pq);
+            res = mul_mod(res, pp.ifac[s % pp.pq], pp.pq);
+            n /= pp.p;
+            r /= pp.p;
+            s /= pp.p;
+            long long carry = n - r - s;
+            e0 += carry;
+            if (e0 >= pp.q) return 0;
+            if (++i >= pp.q) eq += carry;
+        }
+        if ((pp.p != 2 || pp.q < 3) && (eq & 1)) res = (pp.pq - res) % pp.pq;
+        for (int i = 0; i < e0; i++) res = res * pp.p % pp.pq;
+        return res;
+    }
+    /**
+     * @brief 組み合わせの個数(nCr)を mod で割ったあまり
+     */
+    long long nCr(long long n, long long r) const {
+        if (r < 0 || n < r || mod == 1) return 0;
+        long long res = 0, m = 1;
+        for (auto &pp : pps) {
+            long long c = nCr_prime_power(pp, n, r);
+            long long t = mul_mod(((c - res) % pp.pq + pp.pq) % pp.pq, inv_mod(m % pp.pq, pp.pq), pp.pq);
+            res += m * t;
+            m *= pp.pq;
+        }
+        return res;
+    }
+};
+
+
+/**
+ * @brief 必要になった分だけ階乗の表を伸ばす場合の数のクラス
+ *
+ * @tparam T Modint などの型
+ */
+template<typename T>
+struct Lazy_Comb {
+    std::vector<T> fac, ifac;
+    Lazy_Comb() : fac(1, T(1)), ifac(1, T(1)) {}
+    /**
+     * @brief T ごとに共有するインスタンス
+     */
+    static Lazy_Comb &instance() {
+        static Lazy_Comb comb;
+        return comb;
+    }
+    /**
+     * @brief n! まで表を伸ばす (倍々に伸ばすので償却 O(1))
+     */
+    void extend(int n) {
+        int old = fac.size();
+        if (n < old) return;
+        int sz = old;
+        while (sz <= n) sz <<= 1;
+        fac.resize(sz);
+        ifac.resize(sz);
+        for (int i = old; i < sz; i++) {
+            fac[i] = fac[i - 1] * T(i);
+        }
+        ifac[sz - 1] = T(1) / fac[sz - 1];
+        for (int i = sz - 1; i > old; i--) {
+            ifac[i - 1] = ifac[i] * T(i);
+        }
+    }
+    /**
+     * @brief 逆数(1/n)を求める
+     */
+    T inv(int n) {
+        extend(n);
+        return ifac[n] * fac[n - 1];
+    }
+    /**
+     * @brief 順列の個数(nPr)を求める
+     */
+    T nPr(int n, int r) {
+        if (r < 0 || n < r) return T(0);
+        extend(n);
+        return fac[n] * ifac[n - r];
+    }
+    /**
+     * @brief 組み合わせの個数(nCr)を求める
+     */
+    T nCr(int n, int r) {
+        if (r < 0 || n < r) return T(0);
+        extend(n);
+        return fac[n] * ifac[n - r] * ifac[r];
+    }
+    /**
+     * @brief 重複組み合わせの個数(nHr)を求める
+     */
+    T nHr(int n, int r) {
+        if (n == 0 && r == 0) return T(1);
+        if (n <= 0 || r < 0) return T(0);
+        return nCr(n + r - 1, r);
+    }
+    /**
+     * @brief 階乗(n!)を求める
+     */
+    T factorial(int n) {
+        return nPr(n, n);
+    }
+    /**
+     * @brief 階乗の逆数(1/n!)を求める
+     */
+    T inv_factorial(int n) {
+        extend(n);
+        return ifac[n];
+    }
 };
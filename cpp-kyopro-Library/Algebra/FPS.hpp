@@ -0,0 +1,166 @@
+#pragma once
+#include <vector>
+#include <cassert>
+#include "NTT.hpp"
+
+/**
+ * @brief 形式的冪級数
+ * @note NTT.hpp を使用
+ *
+ * @tparam mint 法が NTT-friendly な素数の Modint (Modint998244353 など)
+ */
+template <class mint>
+struct FPS : std::vector<mint> {
+    using std::vector<mint>::vector;
+    FPS(const std::vector<mint> &v) : std::vector<mint>(v) {}
+    FPS(std::vector<mint> &&v) : std::vector<mint>(std::move(v)) {}
+    /**
+     * @brief 先頭 n 項を返す (足りなければ 0 で埋める)
+     */
+    FPS pre(int n) const {
+        FPS res(this->begin(), this->begin() + std::min((int)this->size(), n));
+        res.resize(n);
+        return res;
+    }
+    /**
+     * @brief 加算代入
+     */
+    FPS &operator+=(const FPS &that) {
+        if (this->size() < that.size()) this->resize(that.size());
+        for (int i = 0; i < (int)that.size(); i++) (*this)[i] += that[i];
+        return *this;
+    }
+    /**
+     * @brief 減算代入
+     */
+    FPS &operator-=(const FPS &that) {
+        if (this->size() < that.size()) this->resize(that.size());
+        for (int i = 0; i < (int)that.size(); i++) (*this)[i] -= that[i];
+        return *this;
+    }
+    /**
+     * @brief 乗算代入 (畳み込み)
+     */
+    FPS &operator*=(const FPS &that) {
+        return *this = FPS(convolution<mint>(*this, that));
+    }
+    /**
+     * @brief 定数倍
+     */
+    FPS &operator*=(const mint &c) {
+        for (auto &v : *this) v *= c;
+        return *this;
+    }
+    /**
+     * @brief 加算
+     */
+    FPS operator+(const FPS &that) const {return FPS(*this) += that;}
+    /**
+     * @brief 減算
+     */
+    FPS operator-(const FPS &that) const {return FPS(*this) -= that;}
+    /**
+     * @brief 乗算 (畳み込み)
+     */
+    FPS operator*(const FPS &that) const {return FPS(*this) *= that;}
+    /**
+     * @brief 定数倍
+     */
+    FPS operator*(const mint &c) const {return FPS(*this) *= c;}
+    /**
+     * @brief 微分
+     */
+    FPS diff() const {
+        int n = this->size();
+        FPS res(std::max(0, n - 1));
+        for (int i = 1; i < n; i++) res[i - 1] = (*this)[i] * mint(i);
+        return res;
+    }
+    /**
+     * @brief 積分 (定数項は 0)
+     */
+    FPS integral() const {
+        int n = this->size();
+        FPS res(n + 1);
+        if (n == 0) return res;
+        std::vector<mint> inv(n + 1);
+        inv[1] = 1;
+        for (int i = 2; i <= n; i++) inv[i] = -inv[mint::mod % i] * mint(mint::mod / i);
+        for (int i = 0; i < n; i++) res[i + 1] = (*this)[i] * inv[i + 1];
+        return res;
+    }
+    /**
+     * @brief 逆元 (1 / f) の先頭 deg 項 O(N log N)
+     *
+     * @param deg 求める項数 (-1 なら f と同じ長さ)
+     * @note f[0] != 0 が必要
+     */
+    FPS inv(int deg = -1) const {
+        assert(!this->empty() && (*this)[0] != mint(0));
+        if (deg == -1) deg = this->size();
+        FPS res{(*this)[0].inv()};
+        for (int m = 1; m < deg; m <<= 1) {
+            FPS t = (pre(2 * m) * res).pre(2 * m);
+            for (auto &v : t) v = -v;
+            t[0] += mint(2);
+            res = (res * t).pre(2 * m);
+        }
+        return res.pre(deg);
+    }
+    /**
+     * @brief 対数 (log f) の先頭 deg 項 O(N log N)
+     *
+     * @param deg 求める項数 (-1 なら f と同じ長さ)
+     * @note f[0] == 1 が必要
+     */
+    FPS log(int deg = -1) const {
+        assert(!this->empty() && (*this)[0] == mint(1));
+        if (deg == -1) deg = this->size();
+        return (pre(deg).diff() * inv(deg)).pre(deg - 1).integral();
+    }
+    /**
+     * @brief 指数 (exp f) の先頭 deg 項 O(N log N)
+     *
+     * @param deg 求める項数 (-1 なら f と同じ長さ)
+     * @note f[0] == 0 が必要
+     */
+    FPS exp(int deg = -1) const {
+        assert(this->empty() || (*this)[0] == mint(0));
+        if (deg == -1) deg = this->size();
+        FPS res{mint(1)};
+        for (int m = 1; m < deg; m <<= 1) {
+            FPS t = pre(2 * m) - res.log(2 * m);
+            t[0] += mint(1);
+            res = (res * t).pre(2 * m);
+        }
+        return res.pre(deg);
+    }
+    /**
+     * @brief 累乗 (f^k) の先頭 deg 項 O(N log N)
+     *
+     * @param k 指数
+     * @param deg 求める項数 (-1 なら f と同じ長さ)
+     */
+    FPS pow(long long k, int deg = -1) const {
+        if (deg == -1) deg = this->size();
+        if (k == 0) {
+            FPS res(deg);
+            if (deg) res[0] = 1;
+            return res;
+        }
+        int n = this->size();
+        for (int i = 0; i < n; i++) {
+            if ((*this)[i] == mint(0)) continue;
+            if ((__int128)i * k >= deg) return FPS(deg);
+            mint c = (*this)[i], ic = c.inv();
+            FPS g(this->begin() + i, this->end());
+            g *= ic;
+            g = (g.log(deg - i * k) * mint(k % mint::mod)).exp(deg - i * k);
+            g *= c.pow(k % (mint::mod - 1));
+            FPS res(deg);
+            for (int j = 0; j < (int)g.size(); j++) res[j + i * k] = g[j];
+            return res;
+        }
+        return FPS(deg);
+    }
+};
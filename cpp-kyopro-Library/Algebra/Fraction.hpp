@@ -1,77 +1,223 @@
 #include <cmath>
 #include <numeric>
+#include <limits>
+#include <type_traits>
+#include <stdexcept>
 #include <iostream>
+#include <vector>
+#include <algorithm>
 
 using ll = long long;
 using namespace std;
 
-struct Fraction {
-    ll num, den;
+/**
+ * @brief 分数
+ * @note 四則演算の結果は、I に収まらないときにだけ約分する (演算結果の num, den は約分されているとは限らない。numerator(), denominator() は約分した値を返す)
+ * @note 約分しても I に収まらない結果は overflow_error を投げる (NDEBUG でも切り捨てない)
+ *
+ * @tparam I 分子・分母の型
+ * @tparam W 途中計算の型 (I の積が収まる型。多倍長整数を I, W に指定すればオーバーフローしない)
+ */
+template <class I, class W>
+struct Fraction_T {
+    I num, den;
+    /**
+     * @brief 最大公約数 (非負)
+     */
+    template <class U>
+    static U gcd_(U a, U b) {
+        if (a < 0) a = -a;
+        if (b < 0) b = -b;
+        while (b != 0) {
+            a %= b;
+            swap(a, b);
+        }
+        return a;
+    }
+    /**
+     * @brief W の値が I に収まるか
+     */
+    static bool fits(const W &x) {
+        if constexpr (numeric_limits<I>::is_specialized && numeric_limits<I>::is_bounded && !is_same_v<I, W>) {
+            return W(numeric_limits<I>::min()) <= x && x <= W(numeric_limits<I>::max());
+        } else {
+            return true;
+        }
+    }
+    /**
+     * @brief W の分子・分母から構築 (I に収まらなければ約分し、それでも収まらなければ overflow_error)
+     */
+    static Fraction_T from_wide(W n, W d) {
+        if (d < 0) n = -n, d = -d;
+        if (!fits(n) || !fits(d)) {
+            W g = gcd_(n, d);
+            n /= g;
+            d /= g;
+            if (!fits(n) || !fits(d)) throw overflow_error("Fraction: result does not fit in the numerator/denominator type");
+        }
+        Fraction_T res;
+        res.num = I(n);
+        res.den = I(d);
+        return res;
+    }
     /**
      * @brief 約分
-     * 
+     *
      */
     void simplify() {
-        ll d = gcd(abs(num), abs(den));
+        I d = gcd_(num, den);
+        if (d == 0) return;
         num /= (den >= 0 ? d : -d);
         den /= (den >= 0 ? d : -d);
     }
+    /**
+     * @brief 約分したものを返す
+     */
+    Fraction_T simplified() const {
+        Fraction_T res = *this;
+        res.simplify();
+        return res;
+    }
     /**
      * @brief 整数から分数を構築
-     * 
+     *
      * @param n 整数
      */
-    Fraction(ll n = 0) : num(n), den(1) {};
+    Fraction_T(I n = 0) : num(n), den(1) {};
     /**
-     * @brief a / b の分数を構築
-     * 
+     * @brief a / b の分数を構築 (約分する)
+     *
      * @param a 分子
      * @param b 分母
      */
-    Fraction(ll a, ll b) : num(a), den(b) {
+    Fraction_T(I a, I b) : num(b < 0 ? -a : a), den(b < 0 ? -b : b) {
         simplify();
     };
     /**
-     * @brief 出力
+     * @brief 約分した分子
+     */
+    I numerator() const {
+        return simplified().num;
+    }
+    /**
+     * @brief 約分した分母 (正)
      */
-    friend ostream &operator<<(ostream &os, const Fraction &f) {
-        if (f.den == 1) {
-            os << f.num;
+    I denominator() const {
+        return simplified().den;
+    }
+    /**
+     * @brief 出力 (約分して出力する)
+     */
+    friend ostream &operator<<(ostream &os, const Fraction_T &f) {
+        Fraction_T g = f.simplified();
+        if (g.den == 1) {
+            os << g.num;
         } else {
-            os << f.num <<  '/' << f.den;
+            os << g.num <<  '/' << g.den;
         }
         return os;
     }
-    friend Fraction operator+(const Fraction &a, const Fraction &b) {
-        return {a.num * b.den + b.num * a.den, a.den * b.den};
+    friend Fraction_T operator+(const Fraction_T &a, const Fraction_T &b) {
+        if (a.den == b.den) return from_wide(W(a.num) + W(b.num), W(a.den));
+        return from_wide(W(a.num) * W(b.den) + W(b.num) * W(a.den), W(a.den) * W(b.den));
+    }
+    friend Fraction_T operator-(const Fraction_T &a, const Fraction_T &b) {
+        if (a.den == b.den) return from_wide(W(a.num) - W(b.num), W(a.den));
+        return from_wide(W(a.num) * W(b.den) - W(b.num) * W(a.den), W(a.den) * W(b.den));
+    }
+    friend Fraction_T operator*(const Fraction_T &a, const Fraction_T &b) {
+        return from_wide(W(a.num) * W(b.num), W(a.den) * W(b.den));
     }
-    friend Fraction operator-(const Fraction &a, const Fraction &b) {
-        return {a.num * b.den - b.num * a.den, a.den * b.den};
+    friend Fraction_T operator/(const Fraction_T &a, const Fraction_T &b) {
+        return from_wide(W(a.num) * W(b.den), W(a.den) * W(b.num));
     }
-    friend Fraction operator*(const Fraction &a, const Fraction &b) {
-        ll gcd_tmp1 = gcd(a.num, b.den), gcd_tmp2 = gcd(b.num, a.den);
-        return {(a.num / gcd_tmp1) * (b.num / gcd_tmp2), (a.den / gcd_tmp2) * (b.den / gcd_tmp1)};
+    friend bool operator==(const Fraction_T &a, const Fraction_T &b) {
+        return W(a.num) * W(b.den) == W(b.num) * W(a.den);
     }
-    friend Fraction operator/(const Fraction &a, const Fraction &b) {
-        ll gcd_tmp1 = gcd(a.num, b.num), gcd_tmp2 = gcd(b.den, a.den);
-        return {(b.num >= 0 ? 1 : -1) * (a.num / gcd_tmp1) * (b.den / gcd_tmp2), (b.num >= 0 ? 1 : -1) * (a.den / gcd_tmp2) * (b.num / gcd_tmp1)};
+    friend bool operator!=(const Fraction_T &a, const Fraction_T &b) {
+        return !(a == b);
     }
-    friend bool operator==(const Fraction &a, const Fraction &b) {
-        return a.num == b.num && a.den == b.den;
+    friend bool operator>(const Fraction_T &a, const Fraction_T &b) {
+        return W(a.num) * W(b.den) > W(b.num) * W(a.den);
     }
-    friend bool operator!=(const Fraction &a, const Fraction &b) {
-        return a.num != b.num || a.den != b.den;
+    friend bool operator>=(const Fraction_T &a, const Fraction_T &b) {
+        return W(a.num) * W(b.den) >= W(b.num) * W(a.den);
     }
-    friend bool operator>(const Fraction &a, const Fraction &b) {
-        return a.num * b.den > b.num * a.den;
+    friend bool operator<(const Fraction_T &a, const Fraction_T &b) {
+        return W(a.num) * W(b.den) < W(b.num) * W(a.den);
+    }
+    friend bool operator<=(const Fraction_T &a, const Fraction_T &b) {
+        return W(a.num) * W(b.den) <= W(b.num) * W(a.den);
+    }
+};
+
+using Fraction = Fraction_T<ll, __int128>;
+
+/**
+ * @brief 傾き (分数を構築せずにソート・重複除去するためのキー)
+ * @note den >= 0 に正規化する。den == 0 は +∞ として扱う。約分はしない
+ */
+struct Slope {
+    ll num, den;
+    /**
+     * @brief dy / dx の傾きを構築
+     *
+     * @param dy 分子
+     * @param dx 分母
+     */
+    Slope(ll dy = 0, ll dx = 1) : num(dx < 0 ? -dy : dy), den(dx < 0 ? -dx : dx) {
+        if (den == 0) num = 1;
     }
-    friend bool operator>=(const Fraction &a, const Fraction &b) {
-        return a.num * b.den >= b.num * a.den;
+    friend bool operator<(const Slope &a, const Slope &b) {
+        return (__int128)a.num * b.den < (__int128)b.num * a.den;
     }
-    friend bool operator<(const Fraction &a, const Fraction &b) {
-        return a.num * b.den < b.num * a.den;
+    friend bool operator==(const Slope &a, const Slope &b) {
+        return (__int128)a.num * b.den == (__int128)b.num * a.den;
     }
-    friend bool operator<=(const Fraction &a, const Fraction &b) {
-        return a.num * b.den <= b.num * a.den;
+    /**
+     * @brief 分母が max_den 以下のとき、大小関係と等号を保つ整数のキー floor(num * max_den^2 / den)
+     * @note |num / den| * max_den^2 < 2^63 が必要。+∞ は LLONG_MAX
+     */
+    ll key(ll max_den) const {
+        if (den == 0) return numeric_limits<ll>::max();
+        __int128 t = (__int128)num * max_den * max_den;
+        __int128 q = t / den;
+        if (t % den != 0 && t < 0) --q;
+        return (ll)q;
     }
 };
+
+/**
+ * @brief 傾きをソートして重複を除く O(N log N)
+ */
+void sort_unique_slopes(vector<Slope> &v) {
+    sort(v.begin(), v.end());
+    v.erase(unique(v.begin(), v.end()), v.end());
+}
+
+/**
+ * @brief 分母が max_den 以下の傾きを基数ソートする O(N)
+ *
+ * @param v 傾きの列
+ * @param max_den 分母の最大値
+ */
+void radix_sort_slopes(vector<Slope> &v, ll max_den) {
+    size_t n = v.size();
+    vector<unsigned long long> keys(n), tmp_keys(n);
+    vector<Slope> tmp(n);
+    for (size_t i = 0; i < n; ++i) {
+        keys[i] = (unsigned long long)v[i].key(max_den) ^ (1ULL << 63);
+    }
+    for (int shift = 0; shift < 64; shift += 16) {
+        vector<size_t> cnt((1 << 16) + 1, 0);
+        for (size_t i = 0; i < n; ++i) ++cnt[((keys[i] >> shift) & 0xffff) + 1];
+        for (int b = 0; b < (1 << 16); ++b) cnt[b + 1] += cnt[b];
+        for (size_t i = 0; i < n; ++i) {
+            size_t j = cnt[(keys[i] >> shift) & 0xffff]++;
+            tmp_keys[j] = keys[i];
+            tmp[j] = v[i];
+        }
+        keys.swap(tmp_keys);
+        v.swap(tmp);
+    }
+}
@@ -1,3 +1,4 @@
+#pragma once
 /**
  * @brief 冪乗計算(繰り返し二乗法) O(log n)
  * 
@@ -8,9 +9,10 @@
  */
 long long pow_mod(long long a, long long n, long long mod) {
 	long long res = 1;
+	a %= mod;
 	while (n > 0) {
-		if (n & 1) res = res * a % mod;
-		a = a * a % mod;
+		if (n & 1) res = (__int128)res * a % mod;
+		a = (__int128)a * a % mod;
 		n >>= 1;
 	}
 	return res;
@@ -1,5 +1,7 @@
+#pragma once
 #include <iostream>
 #include <algorithm>
+#include <span>
 
 template <int MOD>
 struct Static_Modint {
@@ -165,10 +167,243 @@ struct Static_Modint {
      * @brief 出力
      */
     friend std::ostream &operator<<(std::ostream &os, const Static_Modint &a) {os << a.val(); return os;}
+    /**
+     * @brief 要素ごとの乗算代入 (a[i] *= b[i])
+     */
+    static void mul_assign(std::span<Static_Modint> a, std::span<const Static_Modint> b) {
+        for (size_t i = 0; i < a.size(); i++) a[i] *= b[i];
+    }
+    /**
+     * @brief 内積 (積の和を 64bit で溜めて剰余を最後にまとめて取る)
+     */
+    static Static_Modint dot(std::span<const Static_Modint> a, std::span<const Static_Modint> b) {
+        const unsigned long long mm = (unsigned long long)mod * mod;
+        unsigned long long s = 0;
+        for (size_t i = 0; i < a.size(); i++) {
+            s += (unsigned long long)a[i].x * b[i].x;
+            if (s >= mm) s -= mm;
+        }
+        Static_Modint t;
+        t.x = s % mod;
+        return t;
+    }
+};
+
+/**
+ * @brief Montgomery 乗算による Static_Modint (法は奇数)
+ * @note 値は x * 2^32 mod MOD の形で保持する。公開している操作は Static_Modint と同じ
+ */
+template <int MOD>
+struct Montgomery_Modint {
+    static_assert(MOD % 2 == 1 && MOD < (1 << 30), "Montgomery_Modint: MOD must be odd and less than 2^30");
+    static const int mod = MOD;
+    /**
+     * @brief MOD * n_inv ≡ -1 (mod 2^32) となる n_inv
+     */
+    static constexpr unsigned int n_inv = [] {
+        unsigned int inv = MOD;
+        for (int i = 0; i < 4; i++) inv *= 2 - MOD * inv;
+        return -inv;
+    }();
+    /**
+     * @brief 2^64 mod MOD
+     */
+    static constexpr unsigned int r2 = (unsigned int)(-(unsigned long long)MOD % MOD);
+    unsigned int x;
+    /**
+     * @brief Montgomery reduction (t * 2^-32 mod MOD)
+     */
+    static unsigned int reduce(unsigned long long t) {
+        unsigned int r = (t + (unsigned long long)((unsigned int)t * n_inv) * MOD) >> 32;
+        return r >= (unsigned int)MOD ? r - MOD : r;
+    }
+    /**
+     * @brief Construct a new Montgomery_Modint object
+     *
+     */
+    Montgomery_Modint() : x(0) {}
+    /**
+     * @brief Construct a new Montgomery_Modint object
+     *
+     * @param sig 代入する数
+     */
+    Montgomery_Modint(signed int sig) {x = reduce((unsigned long long)(sig < 0 ? sig % mod + mod : sig % mod) * r2);}
+    /**
+     * @brief Construct a new Montgomery_Modint object
+     *
+     * @param sig 代入する数
+     */
+    Montgomery_Modint(signed long long sig) {x = reduce((unsigned long long)(sig < 0 ? sig % mod + mod : sig % mod) * r2);}
+    /**
+     * @brief mod を取った値を返す
+     *
+     */
+    int val() const {
+        return (int)reduce(x);
+    }
+    /**
+     * @brief 累乗
+     *
+     * @param n 何乗するか
+     */
+    Montgomery_Modint pow(int n) const {
+        Montgomery_Modint a = *this, res = 1;
+        while (n > 0) {
+            if (n & 1) res *= a;
+            a *= a;
+            n >>= 1;
+        }
+        return res;
+    }
+    /**
+     * @brief 逆元(存在しなければエラー)
+     */
+    Montgomery_Modint inv() const {
+        long long a = val(), b = mod, u = 1, v = 0;
+        while (b) {
+            long long t = a / b;
+            a -= t * b;
+            std::swap(a, b);
+            u -= t * v;
+            std::swap(u, v);
+        }
+        return Montgomery_Modint(u);
+    }
+    /**
+     * @brief 代入
+     */
+    Montgomery_Modint &operator=(signed long long sig) {return *this = Montgomery_Modint(sig);}
+    /**
+     * @brief 代入
+     */
+    Montgomery_Modint &operator=(signed long sig) {return *this = Montgomery_Modint((signed long long)sig);}
+    /**
+     * @brief 代入
+     */
+    Montgomery_Modint &operator=(signed int sig) {return *this = Montgomery_Modint(sig);}
+    /**
+     * @brief 加算代入
+     */
+    Montgomery_Modint &operator+=(Montgomery_Modint that) {if ((x += that.x) >= mod) x -= mod; return *this;}
+    /**
+     * @brief 加算代入
+     */
+    Montgomery_Modint &operator+=(signed long long that) {Montgomery_Modint t = that; *this += t; return *this;}
+    /**
+     * @brief 加算代入
+     */
+    Montgomery_Modint &operator+=(signed long that) {Montgomery_Modint t = (signed long long)that; *this += t; return *this;}
+    /**
+     * @brief 加算代入
+     */
+    Montgomery_Modint &operator+=(signed int that) {Montgomery_Modint t = that; *this += t; return *this;}
+    /**
+     * @brief 減算代入
+     */
+    Montgomery_Modint &operator-=(Montgomery_Modint that) {if ((x += mod - that.x) >= mod) x -= mod; return *this;}
+    /**
+     * @brief 減算代入
+     */
+    Montgomery_Modint &operator-=(signed long long that) {Montgomery_Modint t = that; *this -= t; return *this;}
+    /**
+     * @brief 減算代入
+     */
+    Montgomery_Modint &operator-=(signed long that) {Montgomery_Modint t = (signed long long)that; *this -= t; return *this;}
+    /**
+     * @brief 減算代入
+     */
+    Montgomery_Modint &operator-=(signed int that) {Montgomery_Modint t = that; *this -= t; return *this;}
+    /**
+     * @brief 乗算代入
+     */
+    Montgomery_Modint &operator*=(Montgomery_Modint that) {x = reduce((unsigned long long)x * that.x); return *this;}
+    /**
+     * @brief 乗算代入
+     */
+    Montgomery_Modint &operator*=(signed long long that) {Montgomery_Modint t = that; *this *= t; return *this;}
+    /**
+     * @brief 乗算代入
+     */
+    Montgomery_Modint &operator*=(signed long that) {Montgomery_Modint t = (signed long long)that; *this *= t; return *this;}
+    /**
+     * @brief 乗算代入
+     */
+    Montgomery_Modint &operator*=(signed int that) {Montgomery_Modint t = that; *this *= t; return *this;}
+    /**
+     * @brief 除算代入
+     */
+    Montgomery_Modint &operator/=(Montgomery_Modint that) {return *this *= that.inv();}
+    /**
+     * @brief 除算代入
+     */
+    Montgomery_Modint &operator/=(signed long long that) {Montgomery_Modint t = that; *this /= t; return *this;}
+    /**
+     * @brief 除算代入
+     */
+    Montgomery_Modint &operator/=(signed long that) {Montgomery_Modint t = (signed long long)that; *this /= t; return *this;}
+    /**
+     * @brief 除算代入
+     */
+    Montgomery_Modint &operator/=(signed int that) {Montgomery_Modint t = that; *this /= t; return *this;}
+    /**
+     * @brief 加算
+     */
+    Montgomery_Modint operator+(Montgomery_Modint that) const {return Montgomery_Modint(*this) += that;}
+    /**
+     * @brief 減算
+     */
+    Montgomery_Modint operator-(Montgomery_Modint that) const {return Montgomery_Modint(*this) -= that;}
+    /**
+     * @brief 乗算
+     */
+    Montgomery_Modint operator*(Montgomery_Modint that) const {return Montgomery_Modint(*this) *= that;}
+    /**
+     * @brief 除算
+     */
+    Montgomery_Modint operator/(Montgomery_Modint that) const {return Montgomery_Modint(*this) /= that;}
+    /**
+     * @brief 合同
+     */
+    bool operator==(Montgomery_Modint that) const {return x == that.x;}
+    /**
+     * @brief 合同でない
+     */
+    bool operator!=(Montgomery_Modint that) const {return x != that.x;}
+    /**
+     * @brief -1倍
+     */
+    Montgomery_Modint operator-() const {Montgomery_Modint t; t.x = (x == 0 ? 0 : mod - x); return t;}
+    /**
+     * @brief 出力
+     */
+    friend std::ostream &operator<<(std::ostream &os, const Montgomery_Modint &a) {os << a.val(); return os;}
+    /**
+     * @brief 要素ごとの乗算代入 (a[i] *= b[i])
+     */
+    static void mul_assign(std::span<Montgomery_Modint> a, std::span<const Montgomery_Modint> b) {
+        for (size_t i = 0; i < a.size(); i++) a[i].x = reduce((unsigned long long)a[i].x * b[i].x);
+    }
+    /**
+     * @brief 内積 (Montgomery 形式のまま積を足し込む)
+     */
+    static Montgomery_Modint dot(std::span<const Montgomery_Modint> a, std::span<const Montgomery_Modint> b) {
+        unsigned long long s = 0;
+        for (size_t i = 0; i < a.size(); i++) {
+            s += reduce((unsigned long long)a[i].x * b[i].x);
+        }
+        Montgomery_Modint t;
+        t.x = s % mod;
+        return t;
+    }
 };
 
+#ifdef MODINT_MONTGOMERY
+using Modint998244353 = Montgomery_Modint<998244353>;
+using Modint1000000007 = Montgomery_Modint<1000000007>;
+#else
 using Modint998244353 = Static_Modint<998244353>;
 using Modint1000000007 = Static_Modint<1000000007>;
+#endif
 
 struct Dynamic_Modint {
     int mod;
@@ -281,4 +516,166 @@ struct Dynamic_Modint {
      * @brief 出力
      */
     friend std::ostream &operator<<(std::ostream &os, const Dynamic_Modint &a) {os << a.val(); return os;}
-};
\ No newline at end of file
+};
+
+/**
+ * @brief Barrett reduction で実行時の法による剰余を取る
+ */
+struct Barrett {
+    unsigned int m;
+    unsigned long long im;
+    /**
+     * @brief Construct a new Barrett object
+     *
+     * @param m 法 (1 <= m < 2^31)
+     */
+    explicit Barrett(unsigned int m) : m(m), im((unsigned long long)(-1) / m + 1) {}
+    /**
+     * @brief 法を返す
+     */
+    unsigned int umod() const {
+        return m;
+    }
+    /**
+     * @brief a * b mod m (a, b < m)
+     */
+    unsigned int mul(unsigned int a, unsigned int b) const {
+        unsigned long long z = (unsigned long long)a * b;
+        unsigned long long q = (unsigned long long)(((unsigned __int128)z * im) >> 64);
+        unsigned int v = (unsigned int)(z - q * m);
+        if (m <= v) v += m;
+        return v;
+    }
+};
+
+/**
+ * @brief 実行時に法を決める Modint (法は ID ごとに共有)
+ * @note 値は剰余 1 つのみを持つので Dynamic_Modint の半分の大きさ。法は set_mod で最初に設定する
+ *
+ * @tparam ID 法を共有する単位を区別するタグ
+ */
+template <int ID>
+struct Barrett_Modint {
+    static inline Barrett bt = Barrett(998244353);
+    unsigned int x;
+    /**
+     * @brief 法を設定する(最初に呼ぶ)
+     *
+     * @param m 法
+     */
+    static void set_mod(int m) {
+        bt = Barrett(m);
+    }
+    /**
+     * @brief 法を返す
+     */
+    static int mod() {
+        return (int)bt.umod();
+    }
+    /**
+     * @brief Construct a new Barrett_Modint object
+     */
+    Barrett_Modint() : x(0) {}
+    /**
+     * @brief Construct a new Barrett_Modint object
+     *
+     * @param sig 代入する数
+     */
+    Barrett_Modint(signed int sig) {long long m = mod(); x = (sig < 0 ? sig % m + m : sig % m) % m;}
+    /**
+     * @brief Construct a new Barrett_Modint object
+     *
+     * @param sig 代入する数
+     */
+    Barrett_Modint(signed long long sig) {long long m = mod(); x = (sig < 0 ? sig % m + m : sig % m) % m;}
+    /**
+     * @brief mod を取った値を返す
+     */
+    int val() const {
+        return (int)x;
+    }
+    /**
+     * @brief 累乗
+     *
+     * @param n 何乗するか
+     */
+    Barrett_Modint pow(long long n) const {
+        Barrett_Modint a = *this, res = 1;
+        while (n > 0) {
+            if (n & 1) res *= a;
+            a *= a;
+            n >>= 1;
+        }
+        return res;
+    }
+    /**
+     * @brief 逆元(存在しなければエラー)
+     */
+    Barrett_Modint inv() const {
+        long long a = x, b = mod(), u = 1, v = 0;
+        while (b) {
+            long long t = a / b;
+            a -= t * b;
+            std::swap(a, b);
+            u -= t * v;
+            std::swap(u, v);
+        }
+        return Barrett_Modint(u);
+    }
+    /**
+     * @brief 逆元(存在しなければエラー)
+     */
+    Barrett_Modint inverse() const {
+        return inv();
+    }
+    /**
+     * @brief 加算代入
+     */
+    Barrett_Modint &operator+=(Barrett_Modint that) {if ((x += that.x) >= bt.umod()) x -= bt.umod(); return *this;}
+    /**
+     * @brief 減算代入
+     */
+    Barrett_Modint &operator-=(Barrett_Modint that) {if ((x += bt.umod() - that.x) >= bt.umod()) x -= bt.umod(); return *this;}
+    /**
+     * @brief 乗算代入
+     */
+    Barrett_Modint &operator*=(Barrett_Modint that) {x = bt.mul(x, that.x); return *this;}
+    /**
+     * @brief 除算代入
+     */
+    Barrett_Modint &operator/=(Barrett_Modint that) {return *this *= that.inv();}
+    /**
+     * @brief 加算
+     */
+    Barrett_Modint operator+(Barrett_Modint that) const {return Barrett_Modint(*this) += that;}
+    /**
+     * @brief 減算
+     */
+    Barrett_Modint operator-(Barrett_Modint that) const {return Barrett_Modint(*this) -= that;}
+    /**
+     * @brief 乗算
+     */
+    Barrett_Modint operator*(Barrett_Modint that) const {return Barrett_Modint(*this) *= that;}
+    /**
+     * @brief 除算
+     */
+    Barrett_Modint operator/(Barrett_Modint that) const {return Barrett_Modint(*this) /= that;}
+    /**
+     * @brief 合同
+     */
+    bool operator==(Barrett_Modint that) const {return x == that.x;}
+    /**
+     * @brief 合同でない
+     */
+    bool operator!=(Barrett_Modint that) const {return x != that.x;}
+    /**
+     * @brief -1倍
+     */
+    Barrett_Modint operator-() const {Barrett_Modint t; t.x = (x == 0 ? 0 : bt.umod() - x); return t;}
+    /**
+     * @brief 出力
+     */
+    friend std::ostream &operator<<(std::ostream &os, const Barrett_Modint &a) {os << a.val(); return os;}
+};
+
+using Modint = Barrett_Modint<-1>;
@@ -0,0 +1,154 @@
+#pragma once
+#include <span>
+#include <immintrin.h>
+#include "Modint.hpp"
+
+/**
+ * @brief Modint の列に対する要素ごとの演算 (AVX2 が使えれば 8 要素ずつ計算する)
+ * @note Modint.hpp を使用。AVX2 が使えるかは実行時に判定する
+ *
+ * @tparam mint Static_Modint または Montgomery_Modint (法は奇数)
+ */
+template <class mint>
+struct Modint_SIMD {
+    static_assert(sizeof(mint) == sizeof(unsigned int));
+    static_assert(mint::mod % 2 == 1, "Modint_SIMD: Montgomery reduction requires an odd modulus");
+    static constexpr bool is_montgomery = requires { mint::reduce(0ULL); };
+    static constexpr unsigned int umod = mint::mod;
+    /**
+     * @brief MOD * m_inv ≡ 1 (mod 2^32) となる m_inv
+     */
+    static constexpr unsigned int m_inv = [] {
+        unsigned int inv = umod;
+        for (int i = 0; i < 4; i++) inv *= 2 - umod * inv;
+        return inv;
+    }();
+    /**
+     * @brief 2^64 mod MOD
+     */
+    static constexpr unsigned int r2 = (unsigned int)(-(unsigned long long)umod % umod);
+
+    /**
+     * @brief AVX2 が使えるか
+     */
+    static bool has_avx2() {
+        static const bool res = __builtin_cpu_supports("avx2");
+        return res;
+    }
+
+    /**
+     * @brief 8 要素の Montgomery 乗算 (a * b * 2^-32 mod MOD)
+     */
+    __attribute__((target("avx2")))
+    static __m256i montgomery_mul(__m256i a, __m256i b) {
+        const __m256i m = _mm256_set1_epi32(umod), mi = _mm256_set1_epi32(m_inv);
+        __m256i t_even = _mm256_mul_epu32(a, b);
+        __m256i t_odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+        __m256i qm_even = _mm256_mul_epu32(_mm256_mul_epu32(t_even, mi), m);
+        __m256i qm_odd = _mm256_mul_epu32(_mm256_mul_epu32(t_odd, mi), m);
+        __m256i t_hi = _mm256_blend_epi32(_mm256_srli_epi64(t_even, 32), t_odd, 0b10101010);
+        __m256i qm_hi = _mm256_blend_epi32(_mm256_srli_epi64(qm_even, 32), qm_odd, 0b10101010);
+        __m256i r = _mm256_sub_epi32(t_hi, qm_hi);
+        return _mm256_add_epi32(r, _mm256_and_si256(_mm256_cmpgt_epi32(_mm256_setzero_si256(), r), m));
+    }
+    /**
+     * @brief 8 要素の乗算 (値の表現は mint と同じ)
+     */
+    __attribute__((target("avx2")))
+    static __m256i mul_vec(__m256i a, __m256i b) {
+        if constexpr (is_montgomery) return montgomery_mul(a, b);
+        else return montgomery_mul(montgomery_mul(a, b), _mm256_set1_epi32(r2));
+    }
+    /**
+     * @brief 8 要素の加算
+     */
+    __attribute__((target("avx2")))
+    static __m256i add_vec(__m256i a, __m256i b) {
+        __m256i s = _mm256_add_epi32(a, b);
+        return _mm256_min_epu32(s, _mm256_sub_epi32(s, _mm256_set1_epi32(umod)));
+    }
+    /**
+     * @brief 8 要素の減算
+     */
+    __attribute__((target("avx2")))
+    static __m256i sub_vec(__m256i a, __m256i b) {
+        __m256i d = _mm256_sub_epi32(a, b);
+        return _mm256_min_epu32(d, _mm256_add_epi32(d, _mm256_set1_epi32(umod)));
+    }
+    __attribute__((target("avx2")))
+    static __m256i load(const mint *p) {
+        return _mm256_loadu_si256((const __m256i *)p);
+    }
+    __attribute__((target("avx2")))
+    static void store(mint *p, __m256i v) {
+        _mm256_storeu_si256((__m256i *)p, v);
+    }
+
+    __attribute__((target("avx2")))
+    static size_t add_avx2(std::span<mint> a, std::span<const mint> b) {
+        size_t i = 0;
+        for (; i + 8 <= a.size(); i += 8) store(&a[i], add_vec(load(&a[i]), load(&b[i])));
+        return i;
+    }
+    __attribute__((target("avx2")))
+    static size_t sub_avx2(std::span<mint> a, std::span<const mint> b) {
+        size_t i = 0;
+        for (; i + 8 <= a.size(); i += 8) store(&a[i], sub_vec(load(&a[i]), load(&b[i])));
+        return i;
+    }
+    __attribute__((target("avx2")))
+    static size_t mul_avx2(std::span<mint> a, std::span<const mint> b) {
+        size_t i = 0;
+        for (; i + 8 <= a.size(); i += 8) store(&a[i], mul_vec(load(&a[i]), load(&b[i])));
+        return i;
+    }
+    __attribute__((target("avx2")))
+    static size_t fma_avx2(std::span<mint> a, std::span<const mint> b, std::span<const mint> c) {
+        size_t i = 0;
+        for (; i + 8 <= a.size(); i += 8) store(&a[i], add_vec(load(&a[i]), mul_vec(load(&b[i]), load(&c[i]))));
+        return i;
+    }
+    __attribute__((target("avx2")))
+    static size_t scale_avx2(std::span<mint> a, mint c) {
+        const __m256i cv = _mm256_set1_epi32(c.x);
+        size_t i = 0;
+        for (; i + 8 <= a.size(); i += 8) store(&a[i], mul_vec(load(&a[i]), cv));
+        return i;
+    }
+
+    /**
+     * @brief 加算代入 (a[i] += b[i])
+     */
+    static void add(std::span<mint> a, std::span<const mint> b) {
+        size_t i = has_avx2() ? add_avx2(a, b) : 0;
+        for (; i < a.size(); i++) a[i] += b[i];
+    }
+    /**
+     * @brief 減算代入 (a[i] -= b[i])
+     */
+    static void sub(std::span<mint> a, std::span<const mint> b) {
+        size_t i = has_avx2() ? sub_avx2(a, b) : 0;
+        for (; i < a.size(); i++) a[i] -= b[i];
+    }
+    /**
+     * @brief 乗算代入 (a[i] *= b[i])
+     */
+    static void mul(std::span<mint> a, std::span<const mint> b) {
+        size_t i = has_avx2() ? mul_avx2(a, b) : 0;
+        for (; i < a.size(); i++) a[i] *= b[i];
+    }
+    /**
+     * @brief 積和 (a[i] += b[i] * c[i])
+     */
+    static void fma(std::span<mint> a, std::span<const mint> b, std::span<const mint> c) {
+        size_t i = has_avx2() ? fma_avx2(a, b, c) : 0;
+        for (; i < a.size(); i++) a[i] += b[i] * c[i];
+    }
+    /**
+     * @brief 定数倍 (a[i] *= c)
+     */
+    static void scale(std::span<mint> a, mint c) {
+        size_t i = has_avx2() ? scale_avx2(a, c) : 0;
+        for (; i < a.size(); i++) a[i] *= c;
+    }
+};
@@ -0,0 +1,335 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <bit>
+#include <future>
+#include "Modint.hpp"
+
+namespace ntt_internal {
+    /**
+     * @brief コンパイル時に a^n mod m を求める
+     */
+    constexpr long long pow_mod_constexpr(long long a, long long n, long long m) {
+        long long res = 1;
+        a %= m;
+        while (n > 0) {
+            if (n & 1) res = res * a % m;
+            a = a * a % m;
+            n >>= 1;
+        }
+        return res;
+    }
+
+    /**
+     * @brief コンパイル時に素数 m の原始根を求める
+     */
+    constexpr int primitive_root_constexpr(int m) {
+        if (m == 2) return 1;
+        int divs[20] = {};
+        int cnt = 0;
+        int x = (m - 1) / 2;
+        while (x % 2 == 0) x /= 2;
+        divs[cnt++] = 2;
+        for (int i = 3; (long long)i * i <= x; i += 2) {
+            if (x % i == 0) {
+                divs[cnt++] = i;
+                while (x % i == 0) x /= i;
+            }
+        }
+        if (x > 1) divs[cnt++] = x;
+        for (int g = 2;; g++) {
+            bool ok = true;
+            for (int i = 0; i < cnt; i++) {
+                if (pow_mod_constexpr(g, (m - 1) / divs[i], m) == 1) {
+                    ok = false;
+                    break;
+                }
+            }
+            if (ok) return g;
+        }
+    }
+
+    /**
+     * @brief NTT で使う回転因子の表
+     *
+     * @tparam mint Static_Modint などの法が素数の Modint
+     */
+    template <class mint>
+    struct fft_info {
+        static constexpr int g = primitive_root_constexpr(mint::mod);
+        static constexpr int rank2 = std::countr_zero((unsigned int)(mint::mod - 1));
+        mint root[rank2 + 1], iroot[rank2 + 1];
+        mint rate2[std::max(0, rank2 - 2 + 1)], irate2[std::max(0, rank2 - 2 + 1)];
+        mint rate3[std::max(0, rank2 - 3 + 1)], irate3[std::max(0, rank2 - 3 + 1)];
+        fft_info() {
+            root[rank2] = mint(g).pow((mint::mod - 1) >> rank2);
+            iroot[rank2] = root[rank2].inv();
+            for (int i = rank2 - 1; i >= 0; i--) {
+                root[i] = root[i + 1] * root[i + 1];
+                iroot[i] = iroot[i + 1] * iroot[i + 1];
+            }
+            mint prod = 1, iprod = 1;
+            for (int i = 0; i <= rank2 - 2; i++) {
+                rate2[i] = root[i + 2] * prod;
+                irate2[i] = iroot[i + 2] * iprod;
+                prod *= iroot[i + 2];
+                iprod *= root[i + 2];
+            }
+            prod = 1, iprod = 1;
+            for (int i = 0; i <= rank2 - 3; i++) {
+                rate3[i] = root[i + 3] * prod;
+                irate3[i] = iroot[i + 3] * iprod;
+                prod *= iroot[i + 3];
+                iprod *= root[i + 3];
+            }
+        }
+        /**
+         * @brief 法ごとに一度だけ構築した表を返す
+         */
+        static const fft_info &get() {
+            static const fft_info info;
+            return info;
+        }
+    };
+};
+
+/**
+ * @brief in-place の NTT (radix-4, 出力は bit-reversal 順) O(N log N)
+ *
+ * @tparam mint 法が NTT-friendly な素数の Modint
+ * @param a 変換する列 (長さは 2 冪)
+ */
+template <class mint>
+void butterfly(std::vector<mint> &a) {
+    const auto &info = ntt_internal::fft_info<mint>::get();
+    int n = int(a.size());
+    int h = std::countr_zero((unsigned int)n);
+    int len = 0;
+    while (len < h) {
+        if (h - len == 1) {
+            int p = 1 << (h - len - 1);
+            mint rot = 1;
+            for (int s = 0; s < (1 << len); s++) {
+                int offset = s << (h - len);
+                for (int i = 0; i < p; i++) {
+                    mint l = a[i + offset];
+                    mint r = a[i + offset + p] * rot;
+                    a[i + offset] = l + r;
+                    a[i + offset + p] = l - r;
+                }
+                if (s + 1 != (1 << len)) rot *= info.rate2[std::countr_zero(~(unsigned int)s)];
+            }
+            len++;
+        } else {
+            int p = 1 << (h - len - 2);
+            mint rot = 1, imag = info.root[2];
+            for (int s = 0; s < (1 << len); s++) {
+                mint rot2 = rot * rot;
+                mint rot3 = rot2 * rot;
+                int offset = s << (h - len);
+                for (int i = 0; i < p; i++) {
+                    mint a0 = a[i + offset];
+                    mint a1 = a[i + offset + p] * rot;
+                    mint a2 = a[i + offset + 2 * p] * rot2;
+                    mint a3 = a[i + offset + 3 * p] * rot3;
+                    mint a1na3imag = (a1 - a3) * imag;
+                    a[i + offset] = a0 + a2 + a1 + a3;
+                    a[i + offset + p] = a0 + a2 - a1 - a3;
+                    a[i + offset + 2 * p] = a0 - a2 + a1na3imag;
+                    a[i + offset + 3 * p] = a0 - a2 - a1na3imag;
+                }
+                if (s + 1 != (1 << len)) rot *= info.rate3[std::countr_zero(~(unsigned int)s)];
+            }
+            len += 2;
+        }
+    }
+}
+
+/**
+ * @brief butterfly の逆変換 (N 倍されたまま返す) O(N log N)
+ *
+ * @tparam mint 法が NTT-friendly な素数の Modint
+ * @param a 変換する列 (長さは 2 冪、bit-reversal 順)
+ */
+template <class mint>
+void butterfly_inv(std::vector<mint> &a) {
+    const auto &info = ntt_internal::fft_info<mint>::get();
+    int n = int(a.size());
+    int h = std::countr_zero((unsigned int)n);
+    int len = h;
+    while (len) {
+        if (len == 1) {
+            int p = 1 << (h - len);
+            mint irot = 1;
+            for (int s = 0; s < (1 << (len - 1)); s++) {
+                int offset = s << (h - len + 1);
+                for (int i = 0; i < p; i++) {
+                    mint l = a[i + offset];
+                    mint r = a[i + offset + p];
+                    a[i + offset] = l + r;
+                    a[i + offset + p] = (l - r) * irot;
+                }
+                if (s + 1 != (1 << (len - 1))) irot *= info.irate2[std::countr_zero(~(unsigned int)s)];
+            }
+            len--;
+        } else {
+            int p = 1 << (h - len);
+            mint irot = 1, iimag = info.iroot[2];
+            for (int s = 0; s < (1 << (len - 2)); s++) {
+                mint irot2 = irot * irot;
+                mint irot3 = irot2 * irot;
+                int offset = s << (h - len + 2);
+                for (int i = 0; i < p; i++) {
+                    mint a0 = a[i + offset];
+                    mint a1 = a[i + offset + p];
+                    mint a2 = a[i + offset + 2 * p];
+                    mint a3 = a[i + offset + 3 * p];
+                    mint a2na3iimag = (a2 - a3) * iimag;
+                    a[i + offset] = a0 + a1 + a2 + a3;
+                    a[i + offset + p] = (a0 - a1 + a2na3iimag) * irot;
+                    a[i + offset + 2 * p] = (a0 + a1 - a2 - a3) * irot2;
+                    a[i + offset + 3 * p] = (a0 - a1 - a2na3iimag) * irot3;
+                }
+                if (s + 1 != (1 << (len - 2))) irot *= info.irate3[std::countr_zero(~(unsigned int)s)];
+            }
+            len -= 2;
+        }
+    }
+}
+
+/**
+ * @brief 畳み込み O((N + M) log (N + M))
+ *
+ * @tparam mint 法が NTT-friendly な素数の Modint (Modint998244353 など)
+ * @param a 列
+ * @param b 列
+ * @return std::vector<mint> c[k] = Σ a[i] * b[k - i] (長さ N + M - 1)
+ * @note 作業用の配列はスレッドごとに使い回すので、結果の配列以外は確保しない
+ */
+template <class mint>
+std::vector<mint> convolution(const std::vector<mint> &a, const std::vector<mint> &b) {
+    int n = int(a.size()), m = int(b.size());
+    if (!n || !m) return {};
+    std::vector<mint> res;
+    if (std::min(n, m) <= 60) {
+        res.assign(n + m - 1, mint());
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < m; j++) {
+                res[i + j] += a[i] * b[j];
+            }
+        }
+        return res;
+    }
+    int z = (int)std::bit_ceil((unsigned int)(n + m - 1));
+    static thread_local std::vector<mint> buf;
+    res.reserve(z);
+    res.assign(a.begin(), a.end());
+    res.resize(z);
+    butterfly(res);
+    buf.assign(b.begin(), b.end());
+    buf.resize(z);
+    butterfly(buf);
+    for (int i = 0; i < z; i++) {
+        res[i] *= buf[i];
+    }
+    butterfly_inv(res);
+    res.resize(n + m - 1);
+    mint iz = mint(z).inv();
+    for (int i = 0; i < n + m - 1; i++) res[i] *= iz;
+    return res;
+}
+
+namespace ntt_internal {
+    /**
+     * @brief 3 つの NTT-friendly な素数 (2^24 までの長さに対応)
+     */
+    constexpr int ARB_MOD1 = 754974721, ARB_MOD2 = 167772161, ARB_MOD3 = 469762049;
+
+    /**
+     * @brief 法 MOD のもとで列を畳み込む (入力は [0, MOD) に収まる値)
+     */
+    template <int MOD>
+    std::vector<long long> convolution_with(const std::vector<long long> &a, const std::vector<long long> &b) {
+        using mint = Static_Modint<MOD>;
+        std::vector<mint> a2(a.begin(), a.end()), b2(b.begin(), b.end());
+        auto c = convolution(a2, b2);
+        std::vector<long long> res(c.size());
+        for (int i = 0; i < (int)c.size(); i++) res[i] = c[i].val();
+        return res;
+    }
+};
+
+/**
+ * @brief 任意の法での畳み込み (3 つの素数で NTT をして Garner で復元する) O((N + M) log (N + M))
+ *
+ * @param a 列 (各値は [0, mod))
+ * @param b 列 (各値は [0, mod))
+ * @param mod 法
+ * @return std::vector<long long> 畳み込みを mod で割ったあまり
+ * @note min(N, M) * (mod - 1)^2 < 754974721 * 167772161 * 469762049 (≒ 5.9 * 10^25) が必要
+ * @note 列が長いときは 3 つの NTT をそれぞれ別スレッドで行う
+ */
+std::vector<long long> convolution_arbitrary(const std::vector<long long> &a, const std::vector<long long> &b, long long mod) {
+    using namespace ntt_internal;
+    int n = int(a.size()), m = int(b.size());
+    if (!n || !m) return {};
+    std::vector<long long> c1, c2, c3;
+    if (n + m >= (1 << 16)) {
+        auto f2 = std::async(std::launch::async, convolution_with<ARB_MOD2>, std::cref(a), std::cref(b));
+        auto f3 = std::async(std::launch::async, convolution_with<ARB_MOD3>, std::cref(a), std::cref(b));
+        c1 = convolution_with<ARB_MOD1>(a, b);
+        c2 = f2.get();
+        c3 = f3.get();
+    } else {
+        c1 = convolution_with<ARB_MOD1>(a, b);
+        c2 = convolution_with<ARB_MOD2>(a, b);
+        c3 = convolution_with<ARB_MOD3>(a, b);
+    }
+    const long long m1_inv_m2 = Static_Modint<ARB_MOD2>(ARB_MOD1).inv().val();
+    const long long m12_inv_m3 = (Static_Modint<ARB_MOD3>(ARB_MOD1) * Static_Modint<ARB_MOD3>(ARB_MOD2)).inv().val();
+    const long long m12_mod = (long long)ARB_MOD1 * ARB_MOD2 % mod;
+    std::vector<long long> res(n + m - 1);
+    for (int i = 0; i < n + m - 1; i++) {
+        long long t1 = c1[i];
+        long long t2 = (c2[i] - t1 % ARB_MOD2 + ARB_MOD2) % ARB_MOD2 * m1_inv_m2 % ARB_MOD2;
+        long long r3 = (t1 + t2 * ARB_MOD1) % ARB_MOD3;
+        long long t3 = (c3[i] - r3 + ARB_MOD3) % ARB_MOD3 * m12_inv_m3 % ARB_MOD3;
+        res[i] = (long long)(((unsigned __int128)(t1 % mod) + t2 * ARB_MOD1 % mod + (unsigned __int128)t3 * m12_mod) % mod);
+    }
+    return res;
+}
+
+/**
+ * @brief 任意の法の Modint 列の畳み込み O((N + M) log (N + M))
+ *
+ * @tparam mint Static_Modint, Montgomery_Modint, Barrett_Modint など
+ * @note 条件は convolution_arbitrary(long long) と同じ
+ */
+template <class mint>
+std::vector<mint> convolution_arbitrary(const std::vector<mint> &a, const std::vector<mint> &b) {
+    long long mod;
+    if constexpr (requires { mint::mod(); }) mod = mint::mod();
+    else mod = mint::mod;
+    std::vector<long long> a2(a.size()), b2(b.size());
+    for (int i = 0; i < (int)a.size(); i++) a2[i] = a[i].val();
+    for (int i = 0; i < (int)b.size(); i++) b2[i] = b[i].val();
+    auto c = convolution_arbitrary(a2, b2, mod);
+    return std::vector<mint>(c.begin(), c.end());
+}
+
+/**
+ * @brief Dynamic_Modint 列の畳み込み O((N + M) log (N + M))
+ *
+ * @note 法は a[0] のものを使う。条件は convolution_arbitrary(long long) と同じ
+ */
+std::vector<Dynamic_Modint> convolution_arbitrary(const std::vector<Dynamic_Modint> &a, const std::vector<Dynamic_Modint> &b) {
+    if (a.empty() || b.empty()) return {};
+    int mod = a[0].mod;
+    std::vector<long long> a2(a.size()), b2(b.size());
+    for (int i = 0; i < (int)a.size(); i++) a2[i] = a[i].val();
+    for (int i = 0; i < (int)b.size(); i++) b2[i] = b[i].val();
+    auto c = convolution_arbitrary(a2, b2, mod);
+    std::vector<Dynamic_Modint> res(c.size());
+    for (int i = 0; i < (int)c.size(); i++) res[i] = Dynamic_Modint(c[i], mod);
+    return res;
+}
@@ -1,5 +1,7 @@
 #include <vector>
 #include <algorithm>
+#include <list>
+#include <unordered_map>
 
 using namespace std;
 
@@ -20,4 +22,67 @@ vector<long long> enum_divisors(long long N) {
     }
     sort(res.begin(), res.end());
     return res;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 素因数分解から約数列挙 O(約数の個数 × 指数)
+ *
+ * @param f 素因数とその指数のpair (prime_factorize などの結果)
+ * @param sorted 昇順にするか (全体をソートせず、素因数ごとにマージする)
+ * @return vector<long long> 約数
+ */
+vector<long long> enum_divisors(const vector<pair<long long, long long>> &f, bool sorted = false) {
+    vector<long long> res = {1};
+    for (auto [p, ex] : f) {
+        const vector<long long> base = res;
+        size_t sz = base.size();
+        res.reserve(sz * (ex + 1));
+        long long pw = 1;
+        for (long long e = 0; e < ex; ++e) {
+            pw *= p;
+            for (size_t i = 0; i < sz; ++i)
+                res.push_back(base[i] * pw);
+            if (sorted)
+                inplace_merge(res.begin(), res.end() - sz, res.end());
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief 約数列挙の結果を N ごとに保持する LRU キャッシュ
+ *
+ * @tparam F 素因数分解をする関数 (prime_factorize, prime_factorize_pollard, Linear_Sieve::factorize など)
+ */
+template <class F>
+struct Divisor_Cache {
+    F factorize;
+    size_t capacity;
+    list<pair<long long, vector<long long>>> items;
+    unordered_map<long long, typename list<pair<long long, vector<long long>>>::iterator> pos;
+    /**
+     * @brief Construct a new Divisor_Cache object
+     *
+     * @param factorize 素因数分解をする関数
+     * @param capacity 保持する N の個数 (0 なら 1 とする)
+     */
+    Divisor_Cache(F factorize, size_t capacity) : factorize(factorize), capacity(max<size_t>(capacity, 1)) {}
+    /**
+     * @brief N の約数(昇順) (キャッシュにあれば O(1))
+     * @note 返す参照は次に get を呼ぶと無効になることがある (追い出されうる)。残す場合はコピーすること
+     */
+    const vector<long long> &get(long long N) {
+        auto it = pos.find(N);
+        if (it != pos.end()) {
+            items.splice(items.begin(), items, it->second);
+            return it->second->second;
+        }
+        items.emplace_front(N, enum_divisors(factorize(N), true));
+        pos[N] = items.begin();
+        if (items.size() > capacity) {
+            pos.erase(items.back().first);
+            items.pop_back();
+        }
+        return items.front().second;
+    }
+};
@@ -0,0 +1,140 @@
+#include <vector>
+#include <span>
+
+using namespace std;
+
+/**
+ * @brief 線形篩 (最小素因数の表) 構築 O(N)
+ * @note 素因数分解・約数列挙・オイラーのφ関数・メビウス関数を O(log n) (約数列挙は O(約数の個数)) で求める
+ */
+struct Linear_Sieve {
+	vector<unsigned int> spf;
+	vector<unsigned int> primes;
+	/**
+	 * @brief Construct a new Linear_Sieve object O(N)
+	 *
+	 * @param max 篩の最大値
+	 */
+	Linear_Sieve(unsigned int max) : spf(max + 1, 0) {
+		for (unsigned int i = 2; i <= max; ++i) {
+			if (spf[i] == 0) {
+				spf[i] = i;
+				primes.push_back(i);
+			}
+			for (unsigned int p : primes) {
+				if (p > spf[i] || (unsigned long long)p * i > max)
+					break;
+				spf[p * i] = p;
+			}
+		}
+	}
+	/**
+	 * @brief 素数判定 O(1)
+	 */
+	bool is_prime(unsigned int n) const {
+		return n >= 2 && spf[n] == n;
+	}
+	/**
+	 * @brief 素因数分解 O(log n)
+	 *
+	 * @param n 素因数分解する数 (1 <= n <= max)
+	 * @return vector<pair<long long, long long>> 素因数とその指数のpair
+	 */
+	vector<pair<long long, long long>> factorize(unsigned int n) const {
+		vector<pair<long long, long long>> res;
+		while (n > 1) {
+			unsigned int p = spf[n];
+			long long ex = 0;
+			while (n % p == 0) {
+				++ex;
+				n /= p;
+			}
+			res.push_back({p, ex});
+		}
+		return res;
+	}
+	/**
+	 * @brief 素因数分解をまとめて行う
+	 */
+	vector<vector<pair<long long, long long>>> factorize(span<const unsigned int> ns) const {
+		vector<vector<pair<long long, long long>>> res(ns.size());
+		for (size_t i = 0; i < ns.size(); ++i)
+			res[i] = factorize(ns[i]);
+		return res;
+	}
+	/**
+	 * @brief 約数列挙 O(約数の個数)
+	 *
+	 * @param n 約数列挙する数 (1 <= n <= max)
+	 * @return vector<long long> nの約数(昇順ではない)
+	 */
+	vector<long long> divisors(unsigned int n) const {
+		vector<long long> res = {1};
+		while (n > 1) {
+			unsigned int p = spf[n];
+			size_t sz = res.size();
+			long long pw = 1;
+			while (n % p == 0) {
+				n /= p;
+				pw *= p;
+				for (size_t i = 0; i < sz; ++i)
+					res.push_back(res[i] * pw);
+			}
+		}
+		return res;
+	}
+	/**
+	 * @brief 約数列挙をまとめて行う
+	 */
+	vector<vector<long long>> divisors(span<const unsigned int> ns) const {
+		vector<vector<long long>> res(ns.size());
+		for (size_t i = 0; i < ns.size(); ++i)
+			res[i] = divisors(ns[i]);
+		return res;
+	}
+	/**
+	 * @brief オイラーのφ関数 O(log n)
+	 */
+	long long euler_phi(unsigned int n) const {
+		long long res = n;
+		while (n > 1) {
+			unsigned int p = spf[n];
+			res -= res / p;
+			while (n % p == 0)
+				n /= p;
+		}
+		return res;
+	}
+	/**
+	 * @brief オイラーのφ関数をまとめて求める
+	 */
+	vector<long long> euler_phi(span<const unsigned int> ns) const {
+		vector<long long> res(ns.size());
+		for (size_t i = 0; i < ns.size(); ++i)
+			res[i] = euler_phi(ns[i]);
+		return res;
+	}
+	/**
+	 * @brief メビウス関数 O(log n)
+	 */
+	int mobius(unsigned int n) const {
+		int res = 1;
+		while (n > 1) {
+			unsigned int p = spf[n];
+			n /= p;
+			if (n % p == 0)
+				return 0;
+			res = -res;
+		}
+		return res;
+	}
+	/**
+	 * @brief メビウス関数をまとめて求める
+	 */
+	vector<int> mobius(span<const unsigned int> ns) const {
+		vector<int> res(ns.size());
+		for (size_t i = 0; i < ns.size(); ++i)
+			res[i] = mobius(ns[i]);
+		return res;
+	}
+};
@@ -1,4 +1,6 @@
+#pragma once
 #include <vector>
+#include <span>
 #include "../Mod_pow.hpp"
 
 using namespace std;
@@ -12,7 +14,7 @@ using namespace std;
  * @return false 素数でない
  * @note Mod_pow.hppを使用
  */
-bool is_prime(long long N, vector<long long> A) {
+bool is_prime(long long N, const vector<long long> &A) {
 	if (N <= 1)
 		return false;
 	if (N == 2)
@@ -25,16 +27,104 @@ bool is_prime(long long N, vector<long long> A) {
 		d >>= 1;
 	}
 	for (auto a : A) {
-		if (a % N == 0) return true;
+		if (a % N == 0) continue;
 		long long t, x = pow_mod(a, d, N);
 		if (x != 1) {
 			for (t = 0; t < s; ++t) {
 				if (x == N - 1) break;
-				x = (long long)(x) * x % N;
+				x = (__int128)x * x % N;
 			}
 			if (t == s)
 				return false;
 		}
 	}
 	return true;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 64bit の Montgomery 乗算 (法は奇数)
+ */
+struct Montgomery64 {
+	unsigned long long n, n_inv, r2;
+	Montgomery64(unsigned long long n) : n(n) {
+		n_inv = n;
+		for (int i = 0; i < 5; ++i)
+			n_inv *= 2 - n * n_inv;
+		r2 = (unsigned long long)(((unsigned __int128)1 << 64) % n);
+		r2 = (unsigned long long)((unsigned __int128)r2 * r2 % n);
+	}
+	/**
+	 * @brief t * 2^-64 mod n (t < n * 2^64)
+	 */
+	unsigned long long reduce(unsigned __int128 t) const {
+		unsigned long long q = (unsigned long long)t * n_inv;
+		unsigned long long hi = t >> 64, qn = ((unsigned __int128)q * n) >> 64;
+		return hi >= qn ? hi - qn : hi - qn + n;
+	}
+	unsigned long long mul(unsigned long long a, unsigned long long b) const {
+		return reduce((unsigned __int128)a * b);
+	}
+	unsigned long long to_mont(unsigned long long a) const {
+		return mul(a % n, r2);
+	}
+};
+
+/**
+ * @brief 64bit 整数の決定的なミラー・ラビン素数判定法 O(log N)
+ *
+ * @param N 判定する数
+ * @return true 素数である
+ * @return false 素数でない
+ * @note 2^64 未満で正しい 7 つの底を使う。小さい素数での試し割りを先に行う
+ */
+bool is_prime(unsigned long long N) {
+	static constexpr unsigned long long small[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+	static constexpr unsigned long long bases[] = {2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+	if (N < 2)
+		return false;
+	for (unsigned long long p : small)
+		if (N % p == 0)
+			return N == p;
+	if (N < 37 * 37)
+		return true;
+	Montgomery64 mg(N);
+	const unsigned long long one = mg.to_mont(1), minus_one = N - one;
+	unsigned long long d = N - 1;
+	int s = __builtin_ctzll(d);
+	d >>= s;
+	for (unsigned long long a : bases) {
+		unsigned long long x = mg.to_mont(a);
+		if (x == 0)
+			continue;
+		unsigned long long res = one;
+		for (unsigned long long e = d; e > 0; e >>= 1) {
+			if (e & 1)
+				res = mg.mul(res, x);
+			x = mg.mul(x, x);
+		}
+		if (res == one || res == minus_one)
+			continue;
+		int t = 1;
+		for (; t < s; ++t) {
+			res = mg.mul(res, res);
+			if (res == minus_one)
+				break;
+		}
+		if (t == s)
+			return false;
+	}
+	return true;
+}
+
+/**
+ * @brief 決定的なミラー・ラビン素数判定法をまとめて行う
+ *
+ * @param Ns 判定する数の列
+ * @return vector<bool> 素数かどうかの表
+ */
+vector<bool> is_prime(span<const unsigned long long> Ns) {
+	vector<bool> res(Ns.size());
+	for (size_t i = 0; i < Ns.size(); ++i)
+		res[i] = is_prime(Ns[i]);
+	return res;
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include "Miller–Rabin.hpp"
+
+using namespace std;
+
+/**
+ * @brief Pollard のロー法 (Brent の改良、gcd はまとめて取る) で N の非自明な約数を 1 つ求める O(N^(1/4))
+ *
+ * @param N 合成数
+ * @return long long N の約数 (1 でも N でもない)
+ */
+long long pollard_rho(long long N) {
+	if (N % 2 == 0)
+		return 2;
+	const int M = 128;
+	for (long long c = 1;; ++c) {
+		auto f = [&](long long x) { return (long long)(((__int128)x * x + c) % N); };
+		long long x = 0, y = 2, ys = 2, q = 1, g = 1;
+		for (long long r = 1; g == 1; r <<= 1) {
+			x = y;
+			for (long long i = 0; i < r; ++i)
+				y = f(y);
+			for (long long k = 0; k < r && g == 1; k += M) {
+				ys = y;
+				for (long long i = 0; i < M && i < r - k; ++i) {
+					y = f(y);
+					q = (__int128)q * (x > y ? x - y : y - x) % N;
+				}
+				g = gcd(q, N);
+			}
+		}
+		if (g == N) {
+			do {
+				ys = f(ys);
+				g = gcd(x > ys ? x - ys : ys - x, N);
+			} while (g == 1);
+		}
+		if (g != N)
+			return g;
+	}
+}
+
+/**
+ * @brief 素因数分解 (Pollard のロー法) O(N^(1/4) log N)
+ *
+ * @param N 素因数分解する数 (N <= 1 なら空)
+ * @return vector<pair<long long, long long>> 素因数とその指数のpair(素因数の昇順)
+ * @note Miller–Rabin.hppを使用
+ */
+vector<pair<long long, long long>> prime_factorize_pollard(long long N) {
+	if (N <= 1)
+		return {};
+	vector<long long> ps, st;
+	for (long long p : {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37}) {
+		while (N % p == 0) {
+			ps.push_back(p);
+			N /= p;
+		}
+	}
+	if (N > 1)
+		st.push_back(N);
+	while (!st.empty()) {
+		long long n = st.back();
+		st.pop_back();
+		if (is_prime((unsigned long long)n)) {
+			ps.push_back(n);
+			continue;
+		}
+		long long d = pollard_rho(n);
+		st.push_back(d);
+		st.push_back(n / d);
+	}
+	sort(ps.begin(), ps.end());
+	vector<pair<long long, long long>> res;
+	for (long long p : ps) {
+		if (!res.empty() && res.back().first == p)
+			++res.back().second;
+		else
+			res.push_back({p, 1});
+	}
+	return res;
+}
+
+/**
+ * @brief 約数列挙 (Pollard のロー法) O(N^(1/4) log N + 約数の個数)
+ *
+ * @param N 約数列挙する数
+ * @return vector<long long> Nの約数(昇順)
+ */
+vector<long long> enum_divisors_pollard(long long N) {
+	vector<long long> res = {1};
+	for (auto [p, ex] : prime_factorize_pollard(N)) {
+		size_t sz = res.size();
+		long long pw = 1;
+		for (long long e = 0; e < ex; ++e) {
+			pw *= p;
+			for (size_t i = 0; i < sz; ++i)
+				res.push_back(res[i] * pw);
+		}
+	}
+	sort(res.begin(), res.end());
+	return res;
+}
@@ -0,0 +1,116 @@
+#include <vector>
+#include <cmath>
+#include <thread>
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * @brief Lucy_Hedgehog の方法による素数の個数・総和 O(N^(3/4) / log N) 時間 O(√N) メモリ
+ * @note 構築後は N / k (k = 1, 2, ...) の形の v について π(v) と v 以下の素数の総和が O(1) で求まる
+ *
+ * @tparam T 素数の総和の型 (既定では 2^64 で割ったあまり。__int128 や Modint なども使える)
+ */
+template <typename T = unsigned long long>
+struct Prime_Count {
+	long long N, r;
+	vector<long long> lo_cnt, hi_cnt;
+	vector<T> lo_sum, hi_sum;
+	/**
+	 * @brief 1 から v までの和
+	 */
+	static T sum_to(long long v) {
+		return v % 2 == 0 ? T(v / 2) * T(v + 1) : T(v) * T((v + 1) / 2);
+	}
+	/**
+	 * @brief [0, n) をスレッドに分けて f(i) を呼ぶ
+	 */
+	template <class F>
+	static void parallel_for(long long n, unsigned threads, F f) {
+		if (threads <= 1 || n < (1 << 15)) {
+			for (long long i = 0; i < n; ++i)
+				f(i);
+			return;
+		}
+		vector<thread> ths;
+		for (unsigned t = 0; t < threads; ++t) {
+			ths.emplace_back([&, t] {
+				for (long long i = n * t / threads; i < n * (t + 1) / threads; ++i)
+					f(i);
+			});
+		}
+		for (auto &th : ths)
+			th.join();
+	}
+	/**
+	 * @brief Construct a new Prime_Count object
+	 *
+	 * @param N 上限
+	 * @param threads 大きい v の表を更新するスレッド数 (0 ならハードウェアのスレッド数)
+	 */
+	Prime_Count(long long N, unsigned threads = 1) : N(N) {
+		if (threads == 0)
+			threads = max(1u, thread::hardware_concurrency());
+		r = sqrtl((long double)N);
+		while (r * r > N)
+			--r;
+		while ((r + 1) * (r + 1) <= N)
+			++r;
+		lo_cnt.resize(r + 1);
+		hi_cnt.resize(r + 1);
+		lo_sum.resize(r + 1);
+		hi_sum.resize(r + 1);
+		for (long long i = 1; i <= r; ++i) {
+			lo_cnt[i] = i - 1;
+			lo_sum[i] = sum_to(i) - T(1);
+			hi_cnt[i] = N / i - 1;
+			hi_sum[i] = sum_to(N / i) - T(1);
+		}
+		vector<long long> new_cnt(r + 1);
+		vector<T> new_sum(r + 1);
+		for (long long p = 2; p <= r; ++p) {
+			if (lo_cnt[p] == lo_cnt[p - 1])
+				continue;
+			const long long pc = lo_cnt[p - 1], q = p * p;
+			const T ps = lo_sum[p - 1], pt = T(p);
+			const long long m = min(r, N / q);
+			parallel_for(m, threads, [&](long long j) {
+				long long i = j + 1, d = i * p;
+				long long c = (d <= r ? hi_cnt[d] : lo_cnt[N / d]);
+				T s = (d <= r ? hi_sum[d] : lo_sum[N / d]);
+				new_cnt[i] = hi_cnt[i] - (c - pc);
+				new_sum[i] = hi_sum[i] - pt * (s - ps);
+			});
+			copy(new_cnt.begin() + 1, new_cnt.begin() + m + 1, hi_cnt.begin() + 1);
+			copy(new_sum.begin() + 1, new_sum.begin() + m + 1, hi_sum.begin() + 1);
+			for (long long i = r; i >= q; --i) {
+				lo_cnt[i] -= lo_cnt[i / p] - pc;
+				lo_sum[i] -= pt * (lo_sum[i / p] - ps);
+			}
+		}
+	}
+	/**
+	 * @brief v 以下の素数の個数 (v は N / k の形)
+	 */
+	long long count(long long v) const {
+		return v <= r ? lo_cnt[v] : hi_cnt[N / v];
+	}
+	/**
+	 * @brief v 以下の素数の総和 (v は N / k の形)
+	 */
+	T sum(long long v) const {
+		return v <= r ? lo_sum[v] : hi_sum[N / v];
+	}
+};
+
+/**
+ * @brief N 以下の素数の個数 π(N)
+ *
+ * @param N 上限
+ * @param threads スレッド数
+ */
+long long prime_pi(long long N, unsigned threads = 1) {
+	if (N < 2)
+		return 0;
+	return Prime_Count<>(N, threads).count(N);
+}
@@ -1,4 +1,7 @@
 #include <vector>
+#include <cmath>
+#include <thread>
+#include <algorithm>
 
 using namespace std;
 
@@ -16,7 +19,122 @@ vector<bool> sieve(size_t max){
 	IsPrime[1] = false;
 	for(size_t i=2; i*i<=max; ++i)
 		if(IsPrime[i])
-			for(size_t j=2; i*j<=max; ++j)
+			for(size_t j=i; i*j<=max; ++j)
 				IsPrime[i*j] = false;
 	return IsPrime;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 区間篩 (奇数のみのビット列を L1 キャッシュに収まるブロックごとに篩う)
+ * @note 使用メモリは O(√hi + ブロックの大きさ × スレッド数)
+ */
+struct Segmented_Sieve {
+	static constexpr long long SEGMENT_BITS = 1 << 18;
+	vector<long long> base;
+	long long limit;
+	/**
+	 * @brief Construct a new Segmented_Sieve object O(√max log log √max)
+	 *
+	 * @param max 篩の最大値
+	 */
+	Segmented_Sieve(long long max) : limit(max) {
+		size_t r = sqrtl((long double)max) + 1;
+		while ((long long)r * (long long)r > max) --r;
+		vector<bool> small = sieve(r);
+		for (size_t p = 3; p <= r; p += 2)
+			if (small[p])
+				base.push_back(p);
+	}
+	/**
+	 * @brief 奇数 2k+1 (k ∈ [k0, k0 + 64 * bits.size())) を篩う。bits の立っている位置が素数 (1 を含む)
+	 */
+	void sieve_segment(long long k0, vector<unsigned long long> &bits) const {
+		fill(bits.begin(), bits.end(), ~0ULL);
+		long long k1 = k0 + 64 * (long long)bits.size();
+		for (long long p : base) {
+			if (p * p > 2 * k1 + 1)
+				break;
+			long long first = max(p * p, (2 * k0 + 1 + p - 1) / p * p);
+			if (first % 2 == 0)
+				first += p;
+			for (long long k = (first - 1) / 2; k < k1; k += p)
+				bits[(k - k0) >> 6] &= ~(1ULL << ((k - k0) & 63));
+		}
+	}
+	/**
+	 * @brief [lo, hi) の素数を昇順に f に渡す
+	 *
+	 * @param f 素数を受け取る関数
+	 */
+	template <class F>
+	void for_each_prime(long long lo, long long hi, F f) const {
+		hi = min(hi, limit + 1);
+		if (lo <= 2 && 2 < hi)
+			f(2LL);
+		vector<unsigned long long> bits(SEGMENT_BITS / 64);
+		for (long long k0 = lo / 2; k0 < hi / 2; k0 += SEGMENT_BITS) {
+			sieve_segment(k0, bits);
+			long long k1 = min(k0 + SEGMENT_BITS, hi / 2);
+			for (long long w = 0; k0 + 64 * w < k1; w++) {
+				for (unsigned long long b = bits[w]; b; b &= b - 1) {
+					long long k = k0 + 64 * w + __builtin_ctzll(b);
+					if (k >= k1)
+						break;
+					if (k > 0)
+						f(2 * k + 1);
+				}
+			}
+		}
+	}
+	/**
+	 * @brief [lo, hi) の素数を列挙
+	 */
+	vector<long long> primes(long long lo, long long hi) const {
+		vector<long long> res;
+		for_each_prime(lo, hi, [&](long long p) { res.push_back(p); });
+		return res;
+	}
+	/**
+	 * @brief [lo, hi) の素数の個数 (ブロックをスレッドに分けて数える)
+	 *
+	 * @param threads スレッド数 (0 ならハードウェアのスレッド数)
+	 */
+	long long count_primes(long long lo, long long hi, unsigned threads = 0) const {
+		hi = min(hi, limit + 1);
+		if (lo >= hi)
+			return 0;
+		long long res = (lo <= 2 && 2 < hi);
+		long long kl = lo / 2, kh = hi / 2;
+		if (kl >= kh)
+			return res;
+		long long segments = (kh - kl + SEGMENT_BITS - 1) / SEGMENT_BITS;
+		if (threads == 0)
+			threads = max(1u, thread::hardware_concurrency());
+		threads = (unsigned)min<long long>(threads, segments);
+		vector<long long> cnt(threads, 0);
+		auto work = [&](unsigned id) {
+			vector<unsigned long long> bits(SEGMENT_BITS / 64);
+			for (long long s = id; s < segments; s += threads) {
+				long long k0 = kl + s * SEGMENT_BITS, k1 = min(k0 + SEGMENT_BITS, kh);
+				sieve_segment(k0, bits);
+				long long n = k1 - k0, c = 0;
+				for (long long w = 0; w < n / 64; w++)
+					c += __builtin_popcountll(bits[w]);
+				if (n % 64)
+					c += __builtin_popcountll(bits[n / 64] & ((1ULL << (n % 64)) - 1));
+				if (k0 == 0)
+					--c;
+				cnt[id] += c;
+			}
+		};
+		vector<thread> ths;
+		for (unsigned i = 1; i < threads; i++)
+			ths.emplace_back(work, i);
+		work(0);
+		for (auto &th : ths)
+			th.join();
+		for (long long c : cnt)
+			res += c;
+		return res;
+	}
+};
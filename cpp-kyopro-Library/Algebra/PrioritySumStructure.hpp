@@ -1,4 +1,7 @@
 #include <queue>
+#include <vector>
+#include <random>
+#include <cassert>
 
 using namespace std;
 
@@ -102,6 +105,152 @@ struct PrioritySumStructure {
     }
 };
 
+/**
+ * @brief 多重集合の中で上位 K 個の要素の総積をとる (平衡二分探索木版)
+ * @note 挿入・削除・クエリは O(log n)、set_K は O(1)。削除した要素の分のメモリは再利用する
+ *
+ * @tparam T 集合の要素の型
+ * @tparam (*op)(T, T) 二項演算 (可換)
+ * @tparam (*rop)(T, T) 二項演算の逆関数 (使わないが PrioritySumStructure と揃えている)
+ * @tparam (*e)() 単位元
+ * @tparam comp 比較関数 (comp で先に来る K 個をとる)
+ * @tparam rcomp 比較関数の逆
+ */
+template <class T, T (*op)(T, T), T (*rop)(T, T), T (*e)(), typename comp = less<T>, typename rcomp = greater<T>>
+struct PrioritySumTree {
+    struct Node {
+        T val, agg;
+        unsigned int pri;
+        int size, l, r;
+    };
+    size_t k;
+    int root;
+    vector<Node> nodes;
+    vector<int> free_list;
+    mt19937 rng;
+    PrioritySumTree(int k) : k(k), root(-1) {}
+    int size_of(int t) const {
+        return t < 0 ? 0 : nodes[t].size;
+    }
+    T agg_of(int t) const {
+        return t < 0 ? e() : nodes[t].agg;
+    }
+    int update(int t) {
+        nodes[t].size = size_of(nodes[t].l) + size_of(nodes[t].r) + 1;
+        nodes[t].agg = op(op(agg_of(nodes[t].l), nodes[t].val), agg_of(nodes[t].r));
+        return t;
+    }
+    int merge(int a, int b) {
+        if (a < 0) return b;
+        if (b < 0) return a;
+        if (nodes[a].pri > nodes[b].pri) {
+            nodes[a].r = merge(nodes[a].r, b);
+            return update(a);
+        } else {
+            nodes[b].l = merge(a, nodes[b].l);
+            return update(b);
+        }
+    }
+    /**
+     * @brief comp(v, x) を満たす要素とそれ以外に分ける
+     */
+    pair<int, int> split(int t, const T &x) {
+        if (t < 0) return {-1, -1};
+        if (comp()(nodes[t].val, x)) {
+            auto [a, b] = split(nodes[t].r, x);
+            nodes[t].r = a;
+            return {update(t), b};
+        } else {
+            auto [a, b] = split(nodes[t].l, x);
+            nodes[t].l = b;
+            return {a, update(t)};
+        }
+    }
+    /**
+     * @brief 先頭の要素とそれ以外に分ける
+     */
+    pair<int, int> split_first(int t) {
+        if (nodes[t].l < 0) {
+            int r = nodes[t].r;
+            nodes[t].r = -1;
+            return {update(t), r};
+        }
+        auto [a, b] = split_first(nodes[t].l);
+        nodes[t].l = b;
+        return {a, update(t)};
+    }
+    /**
+     * @brief クエリ (comp で先頭から K 個の総積) O(log n)
+     */
+    T query() const {
+        T res = e();
+        size_t rest = k;
+        int t = root;
+        while (t >= 0 && rest > 0) {
+            if ((size_t)size_of(nodes[t].l) >= rest) {
+                t = nodes[t].l;
+            } else {
+                res = op(res, agg_of(nodes[t].l));
+                res = op(res, nodes[t].val);
+                rest -= size_of(nodes[t].l) + 1;
+                t = nodes[t].r;
+            }
+        }
+        return res;
+    }
+    /**
+     * @brief 要素の挿入
+     */
+    void insert(T x) {
+        int id;
+        if (free_list.empty()) {
+            id = nodes.size();
+            nodes.push_back(Node());
+        } else {
+            id = free_list.back();
+            free_list.pop_back();
+        }
+        nodes[id] = Node{x, x, (unsigned int)rng(), 1, -1, -1};
+        auto [a, b] = split(root, x);
+        root = merge(merge(a, update(id)), b);
+    }
+    /**
+     * @brief 要素の削除
+     */
+    void erase(T x) {
+        assert(size());
+        auto [a, b] = split(root, x);
+        if (b >= 0) {
+            auto [m, c] = split_first(b);
+            if (!comp()(x, nodes[m].val)) {
+                free_list.push_back(m);
+                b = c;
+            } else {
+                b = merge(m, c);
+            }
+        }
+        root = merge(a, b);
+    }
+    /**
+     * @brief Kを設定する
+     */
+    void set_K(size_t kk) {
+        k = kk;
+    }
+    /**
+     * @brief Kの取得
+     */
+    size_t get_K() const {
+        return k;
+    }
+    /**
+     * @brief 要素数の取得
+     */
+    size_t size() const {
+        return size_of(root);
+    }
+};
+
 template<typename T>
 T sum_op(T a, T b) {
     return a + b;
@@ -121,4 +270,10 @@ template<typename T>
 using MaxSumK = PrioritySumStructure<T, sum_op<T>, sum_rop<T>, sum_e<T>, greater<T>, less<T>>;
 
 template<typename T>
-using MinSumK = PrioritySumStructure<T, sum_op<T>, sum_rop<T>, sum_e<T>, less<T>, greater<T>>;
\ No newline at end of file
+using MinSumK = PrioritySumStructure<T, sum_op<T>, sum_rop<T>, sum_e<T>, less<T>, greater<T>>;
+
+template<typename T>
+using MaxSumK_Tree = PrioritySumTree<T, sum_op<T>, sum_rop<T>, sum_e<T>, greater<T>, less<T>>;
+
+template<typename T>
+using MinSumK_Tree = PrioritySumTree<T, sum_op<T>, sum_rop<T>, sum_e<T>, less<T>, greater<T>>;
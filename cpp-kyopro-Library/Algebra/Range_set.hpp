@@ -1,18 +1,145 @@
 #include <iostream>
 #include <set>
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <random>
 
 using namespace std;
 using ll = long long;
 using pll = pair<ll, ll>;
 
+/**
+ * @brief 区間の左端をキーとして区間の長さの和を持つ treap (range_set の kth_absent 用)
+ */
+struct interval_length_index {
+    struct Node {
+        ll key, len, sum;
+        unsigned int pri;
+        int l, r;
+    };
+    int root = -1;
+    vector<Node> nodes;
+    vector<int> free_list;
+    mt19937 rng;
+    ll sum_of(int t) const {
+        return t < 0 ? 0 : nodes[t].sum;
+    }
+    int update(int t) {
+        nodes[t].sum = sum_of(nodes[t].l) + nodes[t].len + sum_of(nodes[t].r);
+        return t;
+    }
+    int merge(int a, int b) {
+        if (a < 0) return b;
+        if (b < 0) return a;
+        if (nodes[a].pri > nodes[b].pri) {
+            nodes[a].r = merge(nodes[a].r, b);
+            return update(a);
+        } else {
+            nodes[b].l = merge(a, nodes[b].l);
+            return update(b);
+        }
+    }
+    /**
+     * @brief キーが x 未満の部分とそれ以外に分ける
+     */
+    pair<int, int> split(int t, ll x) {
+        if (t < 0) return {-1, -1};
+        if (nodes[t].key < x) {
+            auto [a, b] = split(nodes[t].r, x);
+            nodes[t].r = a;
+            return {update(t), b};
+        } else {
+            auto [a, b] = split(nodes[t].l, x);
+            nodes[t].l = b;
+            return {a, update(t)};
+        }
+    }
+    /**
+     * @brief 左端 key, 長さ len の区間を追加 O(log n)
+     */
+    void insert(ll key, ll len) {
+        int id;
+        if (free_list.empty()) {
+            id = nodes.size();
+            nodes.push_back(Node());
+        } else {
+            id = free_list.back();
+            free_list.pop_back();
+        }
+        nodes[id] = Node{key, len, len, (unsigned int)rng(), -1, -1};
+        auto [a, b] = split(root, key);
+        root = merge(merge(a, update(id)), b);
+    }
+    /**
+     * @brief 左端 key の区間を削除 O(log n)
+     */
+    void erase(ll key) {
+        auto [a, b] = split(root, key);
+        auto [m, c] = split(b, key + 1);
+        if (m >= 0) free_list.push_back(m);
+        root = merge(a, c);
+    }
+    /**
+     * @brief 左端が x 未満の区間の長さの和 O(log n)
+     */
+    ll sum_less(ll x) const {
+        ll res = 0;
+        for (int t = root; t >= 0;) {
+            if (nodes[t].key < x) {
+                res += sum_of(nodes[t].l) + nodes[t].len;
+                t = nodes[t].r;
+            } else {
+                t = nodes[t].l;
+            }
+        }
+        return res;
+    }
+    /**
+     * @brief 左端 - (それより前の区間の長さの和) が th を超える最初の区間について、それより前の区間の長さの和 (なければ全体の和) O(log n)
+     * @note 左端 - (前の長さの和) は区間の順に単調非減少
+     */
+    ll sum_before_first_gap_over(ll th) const {
+        ll res = sum_of(root), off = 0;
+        for (int t = root; t >= 0;) {
+            ll before = off + sum_of(nodes[t].l);
+            if (nodes[t].key - before > th) {
+                res = before;
+                t = nodes[t].l;
+            } else {
+                off = before + nodes[t].len;
+                t = nodes[t].r;
+            }
+        }
+        return res;
+    }
+};
+
 struct range_set {
     set<pll> s;
     const ll INF = 5e18;
+    ll covered = 0;
+    interval_length_index lengths;
     range_set() {
         s.emplace(INF, INF);
         s.emplace(-INF, -INF);
     }
 
+    /**
+     * @brief 区間 [l, u] を追加する (lengths にも反映する)
+     */
+    void add_interval(ll l, ll u) {
+        s.emplace(l, u);
+        lengths.insert(l, u - l + 1);
+    }
+    /**
+     * @brief 区間を削除する (lengths にも反映する)
+     */
+    set<pll>::iterator remove_interval(set<pll>::iterator it) {
+        lengths.erase(it->first);
+        return s.erase(it);
+    }
+
     bool contains(ll x) const {
         auto it = prev(s.lower_bound(make_pair(x + 1, x + 1)));
         auto [l, u] = *it;
@@ -26,21 +153,22 @@ struct range_set {
         auto [nl, nu] = *nit;
         if (l <= x && x <= u)
             return false;
+        ++covered;
         if (u == x - 1) {
             if (nl == x + 1) {
-                s.erase(it);
-                s.erase(nit);
-                s.emplace(l, nu);
+                remove_interval(it);
+                remove_interval(nit);
+                add_interval(l, nu);
             } else {
-                s.erase(it);
-                s.emplace(l, x);
+                remove_interval(it);
+                add_interval(l, x);
             }
         } else {
             if (nl == x + 1) {
-                s.erase(nit);
-                s.emplace(x, nu);
+                remove_interval(nit);
+                add_interval(x, nu);
             } else {
-                s.emplace(x, x);
+                add_interval(x, x);
             }
         }
         return true;
@@ -49,28 +177,86 @@ struct range_set {
     bool erase(ll x) {
         auto it = prev(s.lower_bound(make_pair(x + 1, x + 1)));
         auto [l, u] = *it;
+        if (l <= x && x <= u) --covered;
         if (l < x && x < u) {
-            s.erase(it);
-            s.emplace(l, x - 1);
-            s.emplace(x + 1, u);
+            remove_interval(it);
+            add_interval(l, x - 1);
+            add_interval(x + 1, u);
             return true;
         }
         if (l == x) {
-            s.erase(it);
+            remove_interval(it);
             if (x == u) return true;
-            s.emplace(x + 1, u);
+            add_interval(x + 1, u);
             return true;
         }
         if (u == x) {
-            s.erase(it);
+            remove_interval(it);
             if (x == l) return true;
-            s.emplace(l, x - 1);
+            add_interval(l, x - 1);
             return true;
         }
         return false;
     }
 
-    int mex(ll x = 0) const {
+    /**
+     * @brief [l, r) を挿入する (償却 O(log n))
+     * @return ll 新しく追加された要素の個数
+     */
+    ll insert(ll l, ll r) {
+        if (l >= r) return 0;
+        ll L = l, R = r - 1, removed = 0;
+        auto it = s.lower_bound(make_pair(L, -INF));
+        if (prev(it)->second >= L - 1) it = prev(it);
+        while (it->first <= R + 1) {
+            L = min(L, it->first);
+            R = max(R, it->second);
+            removed += it->second - it->first + 1;
+            it = remove_interval(it);
+        }
+        add_interval(L, R);
+        covered += (R - L + 1) - removed;
+        return (R - L + 1) - removed;
+    }
+
+    /**
+     * @brief [l, r) を削除する (償却 O(log n))
+     * @return ll 削除された要素の個数
+     */
+    ll erase(ll l, ll r) {
+        if (l >= r) return 0;
+        ll L = l, R = r - 1, removed = 0;
+        auto it = s.lower_bound(make_pair(L, -INF));
+        if (prev(it)->second >= L) it = prev(it);
+        while (it->first <= R) {
+            auto [a, b] = *it;
+            it = remove_interval(it);
+            removed += min(b, R) - max(a, L) + 1;
+            if (a < L) add_interval(a, L - 1);
+            if (b > R) add_interval(R + 1, b);
+        }
+        covered -= removed;
+        return removed;
+    }
+
+    /**
+     * @brief 区間の個数
+     */
+    size_t interval_count() const {
+        return s.size() - 2;
+    }
+
+    /**
+     * @brief 含まれる要素の個数
+     */
+    ll covered_length() const {
+        return covered;
+    }
+
+    /**
+     * @brief x 以上で含まれない最小の整数 O(log n)
+     */
+    ll mex(ll x = 0) const {
         auto [l, u] = *prev(s.lower_bound(make_pair(x + 1, x + 1)));
         if (l <= x && x <= u) {
             return u + 1;
@@ -79,10 +265,187 @@ struct range_set {
         }
     }
 
+    /**
+     * @brief x 以上で含まれない最小の整数 O(log n)
+     */
+    ll next_absent(ll x) const {
+        return mex(x);
+    }
+
+    /**
+     * @brief x 以下で含まれない最大の整数 O(log n)
+     */
+    ll prev_absent(ll x) const {
+        auto [l, u] = *prev(s.lower_bound(make_pair(x + 1, x + 1)));
+        if (l <= x && x <= u) {
+            return l - 1;
+        } else {
+            return x;
+        }
+    }
+
+    /**
+     * @brief x 以上で含まれない整数のうち k 番目 (0-indexed) O(log n)
+     */
+    ll kth_absent(ll x, ll k) const {
+        ll y = mex(x);
+        ll before = lengths.sum_less(y);
+        return y + k + (lengths.sum_before_first_gap_over(k + y - before) - before);
+    }
+
     friend ostream &operator<<(ostream &os, const range_set &ss) {
         for (auto &p : ss.s) {
             os << "[" << p.first << "," << p.second + 1 << ")" << " ";
         }
         return os;
     }
-};
\ No newline at end of file
+};
+
+/**
+ * @brief 整数の区間の集合 (ソート済み配列版、読み込みが多い場合向け)
+ * @note contains, mex, kth_absent などは O(log n)、挿入・削除は O(log n + 区間の個数)
+ */
+struct flat_range_set {
+    vector<pll> s;
+    ll covered = 0;
+    // prefix[i] := s[0, i) の区間の長さの和 (挿入・削除のたびに変わった位置から更新する)
+    vector<ll> prefix = {0};
+
+    /**
+     * @brief s[i] 以降が変わったときに prefix を更新する
+     */
+    void update_prefix(size_t i) {
+        prefix.resize(s.size() + 1);
+        for (; i < s.size(); ++i)
+            prefix[i + 1] = prefix[i] + (s[i].second - s[i].first + 1);
+    }
+
+    /**
+     * @brief x を含む区間の位置 (なければ -1)
+     */
+    int find(ll x) const {
+        int i = int(upper_bound(s.begin(), s.end(), pll(x, LLONG_MAX)) - s.begin()) - 1;
+        return (i >= 0 && s[i].second >= x) ? i : -1;
+    }
+
+    bool contains(ll x) const {
+        return find(x) >= 0;
+    }
+
+    /**
+     * @brief [l, r) を挿入する
+     * @return ll 新しく追加された要素の個数
+     */
+    ll insert(ll l, ll r) {
+        if (l >= r) return 0;
+        ll L = l, R = r - 1, removed = 0;
+        auto first = lower_bound(s.begin(), s.end(), pll(L, LLONG_MIN));
+        if (first != s.begin() && prev(first)->second >= L - 1) --first;
+        auto last = first;
+        while (last != s.end() && last->first <= R + 1) {
+            L = min(L, last->first);
+            R = max(R, last->second);
+            removed += last->second - last->first + 1;
+            ++last;
+        }
+        size_t i = first - s.begin();
+        auto it = s.erase(first, last);
+        s.insert(it, make_pair(L, R));
+        update_prefix(i);
+        covered += (R - L + 1) - removed;
+        return (R - L + 1) - removed;
+    }
+
+    /**
+     * @brief [l, r) を削除する
+     * @return ll 削除された要素の個数
+     */
+    ll erase(ll l, ll r) {
+        if (l >= r) return 0;
+        ll L = l, R = r - 1, removed = 0;
+        auto first = lower_bound(s.begin(), s.end(), pll(L, LLONG_MIN));
+        if (first != s.begin() && prev(first)->second >= L) --first;
+        auto last = first;
+        vector<pll> rest;
+        while (last != s.end() && last->first <= R) {
+            auto [a, b] = *last;
+            removed += min(b, R) - max(a, L) + 1;
+            if (a < L) rest.emplace_back(a, L - 1);
+            if (b > R) rest.emplace_back(R + 1, b);
+            ++last;
+        }
+        size_t i = first - s.begin();
+        auto it = s.erase(first, last);
+        s.insert(it, rest.begin(), rest.end());
+        update_prefix(i);
+        covered -= removed;
+        return removed;
+    }
+
+    bool insert(ll x) {
+        return insert(x, x + 1) > 0;
+    }
+
+    bool erase(ll x) {
+        return erase(x, x + 1) > 0;
+    }
+
+    /**
+     * @brief 区間の個数
+     */
+    size_t interval_count() const {
+        return s.size();
+    }
+
+    /**
+     * @brief 含まれる要素の個数
+     */
+    ll covered_length() const {
+        return covered;
+    }
+
+    /**
+     * @brief x 以上で含まれない最小の整数 O(log n)
+     */
+    ll mex(ll x = 0) const {
+        int i = find(x);
+        return i >= 0 ? s[i].second + 1 : x;
+    }
+
+    /**
+     * @brief x 以上で含まれない最小の整数 O(log n)
+     */
+    ll next_absent(ll x) const {
+        return mex(x);
+    }
+
+    /**
+     * @brief x 以下で含まれない最大の整数 O(log n)
+     */
+    ll prev_absent(ll x) const {
+        int i = find(x);
+        return i >= 0 ? s[i].first - 1 : x;
+    }
+
+    /**
+     * @brief x 以上で含まれない整数のうち k 番目 (0-indexed) O(log n)
+     */
+    ll kth_absent(ll x, ll k) const {
+        ll y = mex(x);
+        int j = int(upper_bound(s.begin(), s.end(), pll(y, LLONG_MAX)) - s.begin());
+        int lo = j, hi = s.size();
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (s[mid].first - y - (prefix[mid] - prefix[j]) <= k) lo = mid + 1;
+            else hi = mid;
+        }
+        return y + k + (prefix[lo] - prefix[j]);
+    }
+
+    friend ostream &operator<<(ostream &os, const flat_range_set &ss) {
+        for (auto &p : ss.s) {
+            os << "[" << p.first << "," << p.second + 1 << ")" << " ";
+        }
+        return os;
+    }
+};
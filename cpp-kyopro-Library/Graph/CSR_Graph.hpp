@@ -0,0 +1,67 @@
+#pragma once
+#include <vector>
+#include <span>
+
+using namespace std;
+
+/**
+ * @brief CSR (compressed sparse row) 形式のグラフ
+ * @note 辺を 1 本の配列に頂点順で並べる。G.size(), G[v] (辺の span) が vector<vector<E>> と同じように使える
+ *
+ * @tparam E 辺の型
+ */
+template <typename E>
+struct CSR_Graph {
+	vector<int> start;
+	vector<E> elist;
+	CSR_Graph() : start(1, 0) {}
+	/**
+	 * @brief 辺のリストから構築 O(V + E)
+	 *
+	 * @param n 頂点数
+	 * @param edges (始点, 辺) のリスト
+	 */
+	CSR_Graph(int n, const vector<pair<int, E>> &edges) : start(n + 1, 0) {
+		for (auto &p : edges)
+			++start[p.first + 1];
+		for (int i = 0; i < n; i++)
+			start[i + 1] += start[i];
+		if (edges.empty())
+			return;
+		elist.assign(edges.size(), edges[0].second);
+		vector<int> pos(start.begin(), start.end() - 1);
+		for (auto &p : edges)
+			elist[pos[p.first]++] = p.second;
+	}
+	/**
+	 * @brief 隣接リストから構築 O(V + E)
+	 */
+	CSR_Graph(const vector<vector<E>> &G) : start(G.size() + 1, 0) {
+		for (int i = 0; i < (int)G.size(); i++)
+			start[i + 1] = start[i] + G[i].size();
+		elist.reserve(start.back());
+		for (auto &es : G)
+			elist.insert(elist.end(), es.begin(), es.end());
+	}
+	/**
+	 * @brief 頂点数
+	 */
+	int size() const {
+		return start.size() - 1;
+	}
+	/**
+	 * @brief 辺の本数
+	 */
+	int edge_count() const {
+		return elist.size();
+	}
+	/**
+	 * @brief 頂点 v から出る辺
+	 */
+	span<const E> operator[](int v) const {
+		return span<const E>(elist.data() + start[v], elist.data() + start[v + 1]);
+	}
+	span<E> operator[](int v) {
+		return span<E>(elist.data() + start[v], elist.data() + start[v + 1]);
+	}
+};
@@ -1,4 +1,5 @@
 #include <vector>
+#include "CSR_Graph.hpp"
 #include <iostream>
 
 using namespace std;
@@ -10,17 +11,43 @@ struct DP_on_trees {
         T cost;
         edge(int t, T c) : to(t), cost(c) {}
     };
-    using Graph = vector<vector<edge>>;
+    using Graph = CSR_Graph<edge>;
     vector<S> dp;
+    int N;
+    vector<pair<int, edge>> edges;
     Graph G;
-    DP_on_trees(int N) : G(N) {
+    DP_on_trees(int N) : N(N) {
         dp.resize(N, e());
     }
     /**
-     * @brief 有向辺の追加
+     * @brief 構築済みのグラフから構築 (add_edge とは併用しない)
+     */
+    DP_on_trees(const Graph &g) : N(g.size()), G(g) {
+        dp.resize(N, e());
+    }
+    /**
+     * @brief 有向辺の追加 (グラフは build 時に CSR 形式にまとめる)
      */
     void add_edge(int u, int v, T c) {
-        G[u].emplace_back(edge(v, c));
+        edges.emplace_back(u, edge(v, c));
+    }
+    /**
+     * @brief add_edge した辺を CSR 形式のグラフ G にまとめる (まとめた後は辺のリストを解放する)
+     */
+    void pack() {
+        if (G.size() == N && edges.empty()) return;
+        if (G.edge_count() == 0) {
+            G = Graph(N, edges);
+        } else {
+            vector<pair<int, edge>> all;
+            all.reserve(G.edge_count() + edges.size());
+            for (int v = 0; v < G.size(); v++)
+                for (auto &x : G[v]) all.emplace_back(v, x);
+            all.insert(all.end(), edges.begin(), edges.end());
+            G = Graph(N, all);
+        }
+        edges.clear();
+        edges.shrink_to_fit();
     }
     /**
      * @brief DFSをする
@@ -45,6 +72,7 @@ struct DP_on_trees {
      * @param s 根
      */
     void build(int s = 0) {
+        pack();
         dfs(s);
     }
     S operator[](int i) const {
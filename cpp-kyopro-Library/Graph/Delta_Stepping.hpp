@@ -0,0 +1,167 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <barrier>
+#include <algorithm>
+#include <functional>
+#include <climits>
+#include "Dijkstra.hpp"
+
+using namespace std;
+
+/**
+ * @brief Δ-stepping 法による並列の単一始点最短経路 (辺のコストは非負)
+ * @note Dijkstra.hpp を使用。頂点 v はスレッド v % threads が担当し、緩和の要求はスレッドごとのバッファにまとめてから担当スレッドが反映する
+ * 循環させるバケットはスレッドあたり min(最大コスト / Δ + 2, 頂点数 / threads + 2) 個で、それより先の要素は距離のヒープに置いておく
+ *
+ * @tparam T コストの型
+ * @tparam Graph グラフの型 (vector<vector<edge<T>>> または CSR_Graph<edge<T>>)
+ * @param G グラフ
+ * @param s 始点
+ * @param delta バケットの幅 (0 なら 最大コスト / 平均次数)
+ * @param threads スレッド数 (0 ならハードウェアのスレッド数)
+ * @return pair<vector<T>, vector<int>> 最短距離のリストと最短経路のリストのペア
+ */
+template <typename T, class Graph>
+pair<vector<T>, vector<int>> delta_stepping(const Graph &G, int s, T delta = 0, unsigned threads = 0) {
+	struct request {
+		int to, from;
+		T d;
+	};
+	const int n = G.size();
+	if (threads == 0)
+		threads = max(1u, thread::hardware_concurrency());
+	const int P = threads;
+	T max_cost = 0;
+	long long m = 0;
+	for (int v = 0; v < n; v++) {
+		for (auto &e : G[v]) {
+			max_cost = max(max_cost, e.cost);
+			++m;
+		}
+	}
+	if (!(delta > 0)) {
+		delta = max_cost / (T)max(1LL, m / max(1, n));
+		if (!(delta > 0))
+			delta = 1;
+	}
+	// バケット [cur, cur + K) を K 個の配列で循環させ、cur + K 以降に入るものは far (距離の最小ヒープ) に置く
+	// Δ が小さくても配列が大きくなりすぎないように K は頂点数 / P + 2 で抑える
+	const long long K = (long long)min<T>(max_cost / delta, (T)(n / P)) + 2;
+	auto bucket_of = [&](T d) { return (long long)(d / delta); };
+
+	vector<T> dist(n, INF);
+	vector<int> prev(n, -1);
+	vector<char> in_R(n, 0);
+	vector<vector<vector<pair<T, int>>>> buckets(P, vector<vector<pair<T, int>>>(K));
+	vector<vector<pair<T, int>>> far(P);
+	vector<vector<vector<request>>> out(P, vector<vector<request>>(P));
+	vector<long long> local_next(P);
+	vector<char> local_more(P);
+	long long next_bucket = 0;
+	bool more = false;
+	auto reduce = [&]() noexcept {
+		next_bucket = *min_element(local_next.begin(), local_next.end());
+		more = any_of(local_more.begin(), local_more.end(), [](char c) { return c; });
+	};
+	barrier sync(P), sync_reduce(P, reduce);
+
+	dist[s] = 0;
+	buckets[s % P][0].emplace_back(0, s);
+
+	auto worker = [&](int t) {
+		vector<int> R;
+		long long cur = 0;
+		auto push = [&](T d, int v) {
+			long long b = bucket_of(d);
+			if (b < cur + K) {
+				buckets[t][b % K].emplace_back(d, v);
+			} else {
+				far[t].emplace_back(d, v);
+				push_heap(far[t].begin(), far[t].end(), greater<pair<T, int>>());
+			}
+		};
+		// far の先頭の古い要素 (距離が更新済み) を捨てる
+		auto drop_stale = [&]() {
+			while (!far[t].empty() && dist[far[t][0].second] != far[t][0].first) {
+				pop_heap(far[t].begin(), far[t].end(), greater<pair<T, int>>());
+				far[t].pop_back();
+			}
+		};
+		auto apply = [&]() {
+			for (int o = 0; o < P; o++) {
+				for (auto &q : out[o][t]) {
+					if (q.d < dist[q.to]) {
+						dist[q.to] = q.d;
+						prev[q.to] = q.from;
+						push(q.d, q.to);
+					}
+				}
+				out[o][t].clear();
+			}
+		};
+		while (true) {
+			local_next[t] = LLONG_MAX;
+			for (long long j = cur; j < cur + K; j++) {
+				if (!buckets[t][j % K].empty()) {
+					local_next[t] = j;
+					break;
+				}
+			}
+			// far の要素はすべて [cur, cur + K) より後なので、循環バケットが空のときだけ見る
+			drop_stale();
+			if (local_next[t] == LLONG_MAX && !far[t].empty())
+				local_next[t] = bucket_of(far[t][0].first);
+			sync_reduce.arrive_and_wait();
+			cur = next_bucket;
+			if (cur == LLONG_MAX)
+				break;
+			// 窓が進んだので [cur, cur + K) に入った far の要素を循環バケットに移す
+			for (drop_stale(); !far[t].empty() && bucket_of(far[t][0].first) < cur + K; drop_stale()) {
+				pop_heap(far[t].begin(), far[t].end(), greater<pair<T, int>>());
+				auto [d, v] = far[t].back();
+				far[t].pop_back();
+				buckets[t][bucket_of(d) % K].emplace_back(d, v);
+			}
+			// 軽い辺 (コスト Δ 以下) はバケットが空になるまで繰り返し緩和する
+			while (true) {
+				vector<pair<T, int>> B;
+				B.swap(buckets[t][cur % K]);
+				for (auto [d, v] : B) {
+					if (dist[v] != d)
+						continue;
+					if (!in_R[v]) {
+						in_R[v] = 1;
+						R.push_back(v);
+					}
+					for (auto &e : G[v])
+						if (e.cost <= delta)
+							out[t][e.to % P].push_back({e.to, v, d + e.cost});
+				}
+				sync.arrive_and_wait();
+				apply();
+				local_more[t] = !buckets[t][cur % K].empty();
+				sync_reduce.arrive_and_wait();
+				if (!more)
+					break;
+			}
+			// 重い辺はバケットの処理が終わってから 1 回だけ緩和する
+			for (int v : R) {
+				in_R[v] = 0;
+				for (auto &e : G[v])
+					if (e.cost > delta)
+						out[t][e.to % P].push_back({e.to, v, dist[v] + e.cost});
+			}
+			R.clear();
+			sync.arrive_and_wait();
+			apply();
+		}
+	};
+	vector<thread> ths;
+	for (int t = 1; t < P; t++)
+		ths.emplace_back(worker, t);
+	worker(0);
+	for (auto &th : ths)
+		th.join();
+	return make_pair(dist, prev);
+}
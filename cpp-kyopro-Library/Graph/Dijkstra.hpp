@@ -1,10 +1,19 @@
+#pragma once
 #include <vector>
 #include <queue>
+#include <bit>
+#include <climits>
+#include <algorithm>
+#include <type_traits>
+#include <functional>
 
 using namespace std;
 
 #define INF INT_MAX
 
+template <typename E>
+struct CSR_Graph;
+
 /**
  * @brief 辺の構造体
  * 
@@ -18,23 +27,216 @@ struct edge{
 };
 
 /**
- * @brief ダイクストラ法 O(E log V) (E := 辺の本数, V := 頂点の個数)
- * 
+ * @brief 二分ヒープ (重複を許して古い値は取り出し時に捨てる)
+ *
  * @tparam T コストの型
- * @param G グラフ
- * @param s 始点
- * @return pair<vector<T>, vector<int>> 最短距離のリストと最短経路のリストのペア
  */
 template <typename T>
-pair<vector<T>, vector<int>> dijkstra(const vector<vector<edge<T>>> &G, int s) {
+struct Binary_Heap_Queue {
+	static constexpr bool need_max_cost = false;
+	vector<pair<T, int>> Q;
+	Binary_Heap_Queue(int, T) {}
+	/**
+	 * @brief 空にする (確保した領域は残す)
+	 */
+	void clear() {
+		Q.clear();
+	}
+	bool empty() const {
+		return Q.empty();
+	}
+	void push(T key, int v) {
+		Q.emplace_back(key, v);
+		push_heap(Q.begin(), Q.end(), greater<pair<T, int>>());
+	}
+	pair<T, int> pop() {
+		pop_heap(Q.begin(), Q.end(), greater<pair<T, int>>());
+		pair<T, int> p = Q.back();
+		Q.pop_back();
+		return p;
+	}
+};
+
+/**
+ * @brief 基数ヒープ (キーは非負整数で、取り出す値は単調非減少)
+ *
+ * @tparam T コストの型 (整数)
+ */
+template <typename T>
+struct Radix_Heap {
+	static_assert(is_integral_v<T>, "Radix_Heap: T must be an integer type");
+	static constexpr bool need_max_cost = false;
+	using U = make_unsigned_t<T>;
+	static constexpr int B = sizeof(U) * 8;
+	vector<pair<U, int>> buckets[B + 1];
+	U last = 0;
+	size_t sz = 0;
+	Radix_Heap(int, T) {}
+	/**
+	 * @brief 空にする (確保した領域は残す)
+	 */
+	void clear() {
+		for (auto &b : buckets)
+			b.clear();
+		last = 0;
+		sz = 0;
+	}
+	bool empty() const {
+		return sz == 0;
+	}
+	void push(T key, int v) {
+		++sz;
+		buckets[bit_width((U)key ^ last)].emplace_back((U)key, v);
+	}
+	pair<T, int> pop() {
+		if (buckets[0].empty()) {
+			int i = 1;
+			while (buckets[i].empty())
+				++i;
+			last = min_element(buckets[i].begin(), buckets[i].end())->first;
+			for (auto &p : buckets[i])
+				buckets[bit_width(p.first ^ last)].push_back(p);
+			buckets[i].clear();
+		}
+		--sz;
+		auto p = buckets[0].back();
+		buckets[0].pop_back();
+		return {(T)p.first, p.second};
+	}
+};
+
+/**
+ * @brief Dial のバケットキュー (辺のコストが非負整数で最大値が小さい場合)
+ *
+ * @tparam T コストの型 (整数)
+ */
+template <typename T>
+struct Dial_Queue {
+	static_assert(is_integral_v<T>, "Dial_Queue: T must be an integer type");
+	static constexpr bool need_max_cost = true;
+	vector<vector<pair<T, int>>> buckets;
+	T cur = 0;
+	size_t sz = 0;
+	Dial_Queue(int, T max_cost) : buckets(max_cost + 1) {}
+	/**
+	 * @brief 空にする (確保した領域は残す)
+	 */
+	void clear() {
+		for (auto &b : buckets)
+			b.clear();
+		cur = 0;
+		sz = 0;
+	}
+	bool empty() const {
+		return sz == 0;
+	}
+	void push(T key, int v) {
+		++sz;
+		buckets[key % buckets.size()].emplace_back(key, v);
+	}
+	pair<T, int> pop() {
+		while (buckets[cur % buckets.size()].empty())
+			++cur;
+		auto &b = buckets[cur % buckets.size()];
+		--sz;
+		auto p = b.back();
+		b.pop_back();
+		return p;
+	}
+};
+
+/**
+ * @brief 頂点番号で引ける 4 分ヒープ (decrease-key をするので重複がない)
+ *
+ * @tparam T コストの型
+ */
+template <typename T>
+struct Indexed_Four_Ary_Heap {
+	static constexpr bool need_max_cost = false;
+	vector<pair<T, int>> heap;
+	vector<int> pos;
+	Indexed_Four_Ary_Heap(int n, T) : pos(n, -1) {}
+	/**
+	 * @brief 空にする (確保した領域は残す)
+	 */
+	void clear() {
+		for (auto &p : heap)
+			pos[p.second] = -1;
+		heap.clear();
+	}
+	bool empty() const {
+		return heap.empty();
+	}
+	void place(int i, const pair<T, int> &p) {
+		heap[i] = p;
+		pos[p.second] = i;
+	}
+	void sift_up(int i) {
+		pair<T, int> p = heap[i];
+		while (i > 0 && p.first < heap[(i - 1) / 4].first) {
+			place(i, heap[(i - 1) / 4]);
+			i = (i - 1) / 4;
+		}
+		place(i, p);
+	}
+	void sift_down(int i) {
+		pair<T, int> p = heap[i];
+		int n = heap.size();
+		while (true) {
+			int c = 4 * i + 1, best = -1;
+			for (int j = c; j < min(c + 4, n); ++j)
+				if (best < 0 || heap[j].first < heap[best].first)
+					best = j;
+			if (best < 0 || !(heap[best].first < p.first))
+				break;
+			place(i, heap[best]);
+			i = best;
+		}
+		place(i, p);
+	}
+	/**
+	 * @brief v のキーを key にする (ヒープになければ挿入、あれば減少)
+	 */
+	void push(T key, int v) {
+		if (pos[v] < 0) {
+			heap.emplace_back(key, v);
+			pos[v] = heap.size() - 1;
+		} else {
+			heap[pos[v]].first = key;
+		}
+		sift_up(pos[v]);
+	}
+	pair<T, int> pop() {
+		pair<T, int> res = heap[0];
+		pos[res.second] = -1;
+		if (heap.size() > 1) {
+			place(0, heap.back());
+			heap.pop_back();
+			sift_down(0);
+		} else {
+			heap.pop_back();
+		}
+		return res;
+	}
+};
+
+/**
+ * @brief ダイクストラ法の本体 (Graph は G.size() と G[v] の範囲 for が使えればよい)
+ */
+template <typename T, template <typename> class Queue, class Graph>
+pair<vector<T>, vector<int>> dijkstra_impl(const Graph &G, int s) {
 	vector<T> dist(G.size(), INF);
 	vector<int> prev(G.size(), -1);
-	priority_queue<pair<T, int>, vector<pair<T, int>>, greater<pair<T, int>>> Q;
+	T max_cost = 0;
+	if constexpr (Queue<T>::need_max_cost)
+		for (int v = 0; v < (int)G.size(); v++)
+			for (auto &e : G[v])
+				max_cost = max(max_cost, e.cost);
+	Queue<T> Q(G.size(), max_cost);
 	dist[s] = (T)0;
-	Q.emplace(dist[s], s);
+	Q.push(dist[s], s);
 	while (!Q.empty()) {
-		pair<T, int> p = Q.top();
-		Q.pop();
+		pair<T, int> p = Q.pop();
 		int v = p.second;
 		if (dist[v] < p.first)
 			continue;
@@ -42,13 +244,36 @@ pair<vector<T>, vector<int>> dijkstra(const vector<vector<edge<T>>> &G, int s) {
 			if (dist[e.to] > dist[v] + e.cost) {
 				dist[e.to] = dist[v] + e.cost;
 				prev[e.to] = v;
-				Q.emplace(dist[e.to], e.to);
+				Q.push(dist[e.to], e.to);
 			}
 		}
 	}
 	return make_pair(dist, prev);
 }
 
+/**
+ * @brief ダイクストラ法 O(E log V) (E := 辺の本数, V := 頂点の個数)
+ * 
+ * @tparam T コストの型
+ * @tparam Queue 優先度付きキュー (Binary_Heap_Queue, Radix_Heap, Dial_Queue, Indexed_Four_Ary_Heap)
+ * @param G グラフ
+ * @param s 始点
+ * @return pair<vector<T>, vector<int>> 最短距離のリストと最短経路のリストのペア
+ */
+template <typename T, template <typename> class Queue = Binary_Heap_Queue>
+pair<vector<T>, vector<int>> dijkstra(const vector<vector<edge<T>>> &G, int s) {
+	return dijkstra_impl<T, Queue>(G, s);
+}
+
+/**
+ * @brief ダイクストラ法 (CSR 形式のグラフ)
+ * @note CSR_Graph.hpp を使用
+ */
+template <typename T, template <typename> class Queue = Binary_Heap_Queue>
+pair<vector<T>, vector<int>> dijkstra(const CSR_Graph<edge<T>> &G, int s) {
+	return dijkstra_impl<T, Queue>(G, s);
+}
+
 /**
  * @brief 経路復元
  * 
@@ -63,3 +288,116 @@ vector<int> get_path(const vector<int> &prev, int t) {
 	reverse(path.begin(), path.end());
 	return path;
 }
+
+/**
+ * @brief 使い回せるダイクストラ法の作業領域 (クエリごとの計算量は探索した範囲に比例する)
+ * @note 頂点ごとに最後に触れたクエリの番号を持ち、番号が古い頂点は未訪問とみなすので配列の初期化が要らない
+ *
+ * @tparam T コストの型
+ * @tparam Queue 優先度付きキュー
+ * @tparam Graph グラフの型 (vector<vector<edge<T>>> または CSR_Graph<edge<T>>)。G は参照で持つので寿命中に変更しない
+ */
+template <typename T, template <typename> class Queue = Binary_Heap_Queue, class Graph = vector<vector<edge<T>>>>
+struct Dijkstra_Workspace {
+	const Graph &G;
+	vector<T> dist_;
+	vector<int> prev_;
+	vector<unsigned int> stamp;
+	unsigned int cur = 0;
+	vector<int> touched;
+	Queue<T> Q;
+
+	static T max_cost_of(const Graph &G) {
+		T res = 0;
+		if constexpr (Queue<T>::need_max_cost)
+			for (int v = 0; v < (int)G.size(); v++)
+				for (auto &e : G[v])
+					res = max(res, e.cost);
+		return res;
+	}
+	/**
+	 * @brief Construct a new Dijkstra_Workspace object O(V)
+	 *
+	 * @param G グラフ
+	 */
+	Dijkstra_Workspace(const Graph &G) : G(G), dist_(G.size()), prev_(G.size()), stamp(G.size(), 0), Q(G.size(), max_cost_of(G)) {}
+
+	void visit(int v, T d, int p) {
+		if (stamp[v] != cur) {
+			stamp[v] = cur;
+			touched.push_back(v);
+		}
+		dist_[v] = d;
+		prev_[v] = p;
+	}
+	/**
+	 * @brief s から探索する
+	 * @note 距離が bound 以下の頂点だけを探索し、t が確定したら打ち切る。打ち切ったときは確定していない頂点の距離は暫定値
+	 *
+	 * @param s 始点
+	 * @param bound 距離の上限
+	 * @param t 終点 (-1 なら打ち切らない)
+	 */
+	void run(int s, T bound = INF, int t = -1) {
+		if (++cur == 0) {
+			fill(stamp.begin(), stamp.end(), 0);
+			cur = 1;
+		}
+		touched.clear();
+		Q.clear();
+		visit(s, 0, -1);
+		Q.push(0, s);
+		while (!Q.empty()) {
+			auto [d, v] = Q.pop();
+			if (dist_[v] < d)
+				continue;
+			if (v == t)
+				break;
+			for (auto &e : G[v]) {
+				T nd = d + e.cost;
+				if (nd > bound)
+					continue;
+				if (stamp[e.to] != cur || nd < dist_[e.to]) {
+					visit(e.to, nd, v);
+					Q.push(nd, e.to);
+				}
+			}
+		}
+	}
+	/**
+	 * @brief 直前の探索での v までの距離 (到達していなければ INF)
+	 */
+	T dist(int v) const {
+		return stamp[v] == cur ? dist_[v] : (T)INF;
+	}
+	/**
+	 * @brief 直前の探索での v の直前の頂点 (到達していなければ -1)
+	 */
+	int prev(int v) const {
+		return stamp[v] == cur ? prev_[v] : -1;
+	}
+	/**
+	 * @brief 直前の探索で v に到達したか
+	 */
+	bool reached(int v) const {
+		return stamp[v] == cur;
+	}
+	/**
+	 * @brief 直前の探索で到達した頂点 O(1)
+	 */
+	const vector<int> &visited() const {
+		return touched;
+	}
+	/**
+	 * @brief 直前の探索での t までの最短経路 (到達していなければ空)
+	 */
+	vector<int> get_path(int t) const {
+		vector<int> path;
+		if (stamp[t] != cur)
+			return path;
+		for (int v = t; v != -1; v = prev_[v])
+			path.push_back(v);
+		reverse(path.begin(), path.end());
+		return path;
+	}
+};
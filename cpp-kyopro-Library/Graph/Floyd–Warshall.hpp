@@ -1,4 +1,8 @@
 #include <vector>
+#include <thread>
+#include <limits>
+#include <climits>
+#include <algorithm>
 
 using namespace std;
 
@@ -29,7 +33,7 @@ vector<vector<T>> warshall_floyd(vector<vector<edge<T>>> &G, int n) {
 	vector<vector<T>> dist(n + 1, vector<T>(n + 1, INF));
 	for (int i = 0; i < n; i++) {
 		for (auto e : G[i])
-			dist[i][e.to] = e.weight;
+			dist[i][e.to] = min(dist[i][e.to], e.weight);
 		dist[i][i] = 0;
 	}
 	for (int i = 0; i < n; i++)
@@ -38,4 +42,106 @@ vector<vector<T>> warshall_floyd(vector<vector<edge<T>>> &G, int n) {
 				if (dist[j][i] != INF && dist[i][k] != INF)
 					dist[j][k] = min(dist[j][k], dist[j][i] + dist[i][k]);
 	return dist;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief ブロック化したワーシャルフロイド法で、B × B のタイル 1 枚を k 列目 (pivot) のタイルで更新する
+ * @note 内側のループは分岐のない min なので、-O2 でもベクトル化する (AVX2 が使えるかは実行時に判定する)
+ */
+template <typename T>
+__attribute__((target_clones("avx2", "default"), optimize("tree-vectorize", "vect-cost-model=dynamic")))
+void warshall_floyd_tile(T *d, int n, int i0, int i1, int j0, int j1, int k0, int k1) {
+	for (int k = k0; k < k1; k++) {
+		const T *dk = d + (size_t)k * n;
+		for (int i = i0; i < i1; i++) {
+			T *di = d + (size_t)i * n;
+			const T a = di[k];
+			// i == k のとき di == dk だが、a = 0 なので値は変わらない
+#pragma GCC ivdep
+			for (int j = j0; j < j1; j++) {
+				T x = a + dk[j];
+				di[j] = x < di[j] ? x : di[j];
+			}
+		}
+	}
+}
+
+/**
+ * @brief ワーシャルフロイド法 (ブロック化・マルチスレッド) O(n^3)
+ * @note 距離は n × n の行優先の 1 次元配列 (i から j は dist[i * n + j])。到達できなければ INF
+ * @note 整数では到達できない距離を numeric_limits<T>::max() / 4 で表して分岐なしに足すので、最短距離の絶対値はその半分未満であること
+ *
+ * @tparam T コストの型
+ * @param G グラフ
+ * @param n 頂点数
+ * @param threads スレッド数 (0 ならハードウェアのスレッド数)
+ * @param B タイルの一辺
+ * @return vector<T> 最短距離の行列
+ */
+template <typename T>
+vector<T> warshall_floyd_blocked(const vector<vector<edge<T>>> &G, int n, unsigned threads = 1, int B = 64) {
+	if (threads == 0)
+		threads = max(1u, thread::hardware_concurrency());
+	const T big = numeric_limits<T>::has_infinity ? numeric_limits<T>::infinity() : numeric_limits<T>::max() / 4;
+	vector<T> dist((size_t)n * n, big);
+	T *d = dist.data();
+	for (int i = 0; i < n; i++) {
+		for (auto &e : G[i])
+			d[(size_t)i * n + e.to] = min(d[(size_t)i * n + e.to], e.weight);
+		d[(size_t)i * n + i] = min(d[(size_t)i * n + i], (T)0);
+	}
+	const int nb = (n + B - 1) / B;
+	auto parallel_for = [&](int cnt, auto f) {
+		if (threads <= 1 || cnt <= 1) {
+			for (int x = 0; x < cnt; x++)
+				f(x);
+			return;
+		}
+		vector<thread> ths;
+		for (unsigned t = 0; t < threads; t++) {
+			ths.emplace_back([&, t] {
+				for (int x = t; x < cnt; x += threads)
+					f(x);
+			});
+		}
+		for (auto &th : ths)
+			th.join();
+	};
+	for (int kb = 0; kb < nb; kb++) {
+		const int k0 = kb * B, k1 = min(n, k0 + B);
+		// 1. pivot のタイル
+		warshall_floyd_tile(d, n, k0, k1, k0, k1, k0, k1);
+		// 2. pivot と同じ行・列のタイル (互いに独立)
+		parallel_for(2 * nb, [&](int x) {
+			int b = x >> 1;
+			if (b == kb)
+				return;
+			int b0 = b * B, b1 = min(n, b0 + B);
+			if (x & 1)
+				warshall_floyd_tile(d, n, b0, b1, k0, k1, k0, k1);
+			else
+				warshall_floyd_tile(d, n, k0, k1, b0, b1, k0, k1);
+		});
+		// 3. 残りのタイル (互いに独立、行ごとに分ける)
+		parallel_for(nb, [&](int ib) {
+			if (ib == kb)
+				return;
+			int i0 = ib * B, i1 = min(n, i0 + B);
+			for (int jb = 0; jb < nb; jb++) {
+				if (jb == kb)
+					continue;
+				warshall_floyd_tile(d, n, i0, i1, jb * B, min(n, jb * B + B), k0, k1);
+			}
+		});
+	}
+	if constexpr (!numeric_limits<T>::has_infinity) {
+		for (auto &x : dist)
+			if (x >= big / 2)
+				x = INF;
+	} else {
+		for (auto &x : dist)
+			if (x == big)
+				x = INF;
+	}
+	return dist;
+}
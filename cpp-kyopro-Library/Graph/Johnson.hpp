@@ -0,0 +1,131 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <thread>
+#include <atomic>
+#include <type_traits>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include "Dijkstra.hpp"
+
+using namespace std;
+
+/**
+ * @brief SPFA (キューを使うベルマンフォード法) で全頂点から距離 0 の仮想始点からの距離を求める O(VE)
+ * @note Johnson 法のポテンシャルに使う。負閉路があれば false
+ *
+ * @tparam T コストの型
+ * @tparam Graph グラフの型 (vector<vector<edge<T>>> または CSR_Graph<edge<T>>)
+ * @param G グラフ
+ * @param h ポテンシャル (出力)
+ * @return bool 負閉路がなければ true
+ */
+template <typename T, class Graph>
+bool johnson_potential(const Graph &G, vector<T> &h) {
+	int n = G.size();
+	h.assign(n, 0);
+	bool negative = false;
+	for (int v = 0; v < n && !negative; v++)
+		for (auto &e : G[v])
+			if (e.cost < 0)
+				negative = true;
+	if (!negative)
+		return true;
+	// len[v] := 仮想始点から v までの暫定の経路の辺数。n を超えたら経路が閉路を含むので負閉路がある
+	vector<int> len(n, 1);
+	vector<char> in_queue(n, 1);
+	deque<int> Q;
+	for (int v = 0; v < n; v++)
+		Q.push_back(v);
+	while (!Q.empty()) {
+		int v = Q.front();
+		Q.pop_front();
+		in_queue[v] = 0;
+		for (auto &e : G[v]) {
+			if (h[e.to] > h[v] + e.cost) {
+				h[e.to] = h[v] + e.cost;
+				len[e.to] = len[v] + 1;
+				if (len[e.to] > n)
+					return false;
+				if (!in_queue[e.to]) {
+					in_queue[e.to] = 1;
+					Q.push_back(e.to);
+				}
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Johnson 法で全点対間最短距離を 1 行ずつ求める O(VE log V)
+ * @note Dijkstra.hpp を使用。f(s, dist) は threads > 1 のとき複数のスレッドから同時に呼ばれる。dist は呼び出しの間だけ有効
+ *
+ * @tparam Graph グラフの型 (vector<vector<edge<T>>> または CSR_Graph<edge<T>>)
+ * @tparam F void(int s, const vector<T> &dist) の関数 (到達できない頂点は INF)
+ * @param G グラフ
+ * @param f 始点ごとに呼ぶ関数
+ * @param threads スレッド数 (0 ならハードウェアのスレッド数)
+ * @return bool 負閉路がなければ true (負閉路があれば f は呼ばれない)
+ */
+template <class Graph, class F>
+bool johnson_for_each(const Graph &G, F f, unsigned threads = 1) {
+	using T = remove_cvref_t<decltype(G[0].begin()->cost)>;
+	int n = G.size();
+	vector<T> h;
+	if (!johnson_potential<T>(G, h))
+		return false;
+	if (threads == 0)
+		threads = max(1u, thread::hardware_concurrency());
+	atomic<int> next(0);
+	// 再重み付けした距離は実際の距離よりずっと大きくなりうるので、上限は INF ではなく型の最大値にする
+	auto worker = [&](const Graph &H) {
+		Dijkstra_Workspace<T, Binary_Heap_Queue, Graph> W(H);
+		vector<T> row(n);
+		for (int s; (s = next.fetch_add(1)) < n;) {
+			W.run(s, numeric_limits<T>::max());
+			for (int v = 0; v < n; v++)
+				row[v] = (W.reached(v) ? W.dist(v) - h[s] + h[v] : (T)INF);
+			f(s, (const vector<T> &)row);
+		}
+	};
+	// 負の辺がなければ (h がすべて 0) そのまま使い、あれば入力と同じ形式で写して cost + h[u] - h[v] (非負) に再重み付けする
+	Graph RG;
+	const Graph *H = &G;
+	if (any_of(h.begin(), h.end(), [](const T &x) { return x != 0; })) {
+		RG = G;
+		for (int v = 0; v < n; v++)
+			for (auto &e : RG[v])
+				e.cost += h[v] - h[e.to];
+		H = &RG;
+	}
+	vector<thread> ths;
+	for (unsigned t = 1; t < threads; t++)
+		ths.emplace_back(worker, cref(*H));
+	worker(*H);
+	for (auto &th : ths)
+		th.join();
+	return true;
+}
+
+/**
+ * @brief Johnson 法で全点対間最短距離を求める O(VE log V)
+ * @note Dijkstra.hpp を使用
+ *
+ * @param G グラフ
+ * @param threads スレッド数 (0 ならハードウェアのスレッド数)
+ * @return vector<T> n × n の行優先の 1 次元配列 (i から j は dist[i * n + j]、到達できなければ INF)。負閉路があれば空
+ */
+template <class Graph>
+auto johnson(const Graph &G, unsigned threads = 1) {
+	using T = remove_cvref_t<decltype(G[0].begin()->cost)>;
+	size_t n = G.size();
+	vector<T> dist(n * n);
+	bool ok = johnson_for_each(G, [&](int s, const vector<T> &row) {
+		copy(row.begin(), row.end(), dist.begin() + s * n);
+	}, threads);
+	if (!ok)
+		dist.clear();
+	return dist;
+}
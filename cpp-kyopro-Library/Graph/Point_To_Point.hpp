@@ -0,0 +1,220 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include "Dijkstra.hpp"
+
+using namespace std;
+
+/**
+ * @brief 2 頂点間の最短経路 (双方向ダイクストラ法, A*, ALT)
+ * @note Dijkstra.hpp を使用。t が確定した時点で探索を打ち切る。作業用の配列はクエリ間で使い回し、前回触れた頂点だけを初期化する
+ *
+ * @tparam T コストの型
+ * @tparam Graph グラフの型 (vector<vector<edge<T>>> または CSR_Graph<edge<T>>)。G は参照で持つので寿命中に変更しない
+ */
+template <typename T, class Graph = vector<vector<edge<T>>>>
+struct Point_To_Point {
+	using Heap = vector<pair<T, int>>;
+	const Graph &G;
+	vector<vector<edge<T>>> RG;
+	vector<T> dist[2];
+	vector<int> prev[2];
+	vector<int> touched[2];
+	Heap heap[2];
+	vector<int> landmarks;
+	vector<vector<T>> from_landmark, to_landmark;
+	int meet = -1;
+
+	/**
+	 * @brief Construct a new Point_To_Point object O(V + E)
+	 *
+	 * @param G グラフ
+	 */
+	Point_To_Point(const Graph &G) : G(G), RG(G.size()) {
+		int n = G.size();
+		for (int v = 0; v < n; v++)
+			for (auto &e : G[v])
+				RG[e.to].emplace_back(v, e.cost);
+		for (int d = 0; d < 2; d++) {
+			dist[d].assign(n, INF);
+			prev[d].assign(n, -1);
+		}
+	}
+	/**
+	 * @brief 前回のクエリで触れた頂点だけを初期化する
+	 */
+	void reset() {
+		for (int d = 0; d < 2; d++) {
+			for (int v : touched[d]) {
+				dist[d][v] = INF;
+				prev[d][v] = -1;
+			}
+			touched[d].clear();
+			heap[d].clear();
+		}
+		meet = -1;
+	}
+	void push(int d, int v, T nd, int p, T key) {
+		if (dist[d][v] == (T)INF)
+			touched[d].push_back(v);
+		dist[d][v] = nd;
+		prev[d][v] = p;
+		heap[d].emplace_back(key, v);
+		push_heap(heap[d].begin(), heap[d].end(), greater<pair<T, int>>());
+	}
+	pair<T, int> pop(int d) {
+		pop_heap(heap[d].begin(), heap[d].end(), greater<pair<T, int>>());
+		pair<T, int> p = heap[d].back();
+		heap[d].pop_back();
+		return p;
+	}
+	template <class G2>
+	void relax(int d, const G2 &g, int v) {
+		for (auto &e : g[v])
+			if (dist[d][e.to] > dist[d][v] + e.cost)
+				push(d, e.to, dist[d][v] + e.cost, v, dist[d][v] + e.cost);
+	}
+
+	/**
+	 * @brief 双方向ダイクストラ法
+	 *
+	 * @param s 始点
+	 * @param t 終点
+	 * @return T s から t への最短距離 (到達できなければ INF)
+	 */
+	T bidirectional(int s, int t) {
+		reset();
+		push(0, s, 0, -1, 0);
+		push(1, t, 0, -1, 0);
+		if (s == t) {
+			meet = s;
+			return 0;
+		}
+		T best = INF;
+		while (!heap[0].empty() && !heap[1].empty()) {
+			// 両側の最小値の和が暫定値以上なら、それより短い経路はない
+			if (best != (T)INF && heap[0][0].first + heap[1][0].first >= best)
+				break;
+			int d = heap[0].size() <= heap[1].size() ? 0 : 1;
+			auto [k, v] = pop(d);
+			if (dist[d][v] < k)
+				continue;
+			// 緩和した先が反対側から到達済みなら暫定値を更新する
+			auto scan = [&](auto &g) {
+				relax(d, g, v);
+				for (auto &e : g[v]) {
+					int w = e.to;
+					if (dist[1 - d][w] != (T)INF && dist[0][w] + dist[1][w] < best) {
+						best = dist[0][w] + dist[1][w];
+						meet = w;
+					}
+				}
+			};
+			if (d == 0)
+				scan(G);
+			else
+				scan(RG);
+		}
+		return best;
+	}
+
+	/**
+	 * @brief A* 探索
+	 *
+	 * @param s 始点
+	 * @param t 終点
+	 * @param h 頂点 v から t までの距離の下界 (h(t) = 0 かつ h(u) <= cost(u, v) + h(v) を満たすこと)
+	 * @return T s から t への最短距離 (到達できなければ INF)
+	 */
+	template <class H>
+	T astar(int s, int t, H h) {
+		reset();
+		push(0, s, 0, -1, h(s));
+		while (!heap[0].empty()) {
+			auto [k, v] = pop(0);
+			if (dist[0][v] + h(v) < k)
+				continue;
+			if (v == t) {
+				meet = t;
+				return dist[0][t];
+			}
+			for (auto &e : G[v])
+				if (dist[0][e.to] > dist[0][v] + e.cost)
+					push(0, e.to, dist[0][v] + e.cost, v, dist[0][v] + e.cost + h(e.to));
+		}
+		return INF;
+	}
+
+	/**
+	 * @brief ALT のランドマークを選んで距離表を作る O(k E log V)
+	 * @note 最初は頂点 first、以降はそれまでのランドマークから最も遠い頂点を選ぶ
+	 *
+	 * @param k ランドマークの個数
+	 * @param first 最初のランドマーク
+	 */
+	void build_landmarks(int k, int first = 0) {
+		int n = G.size();
+		landmarks.clear();
+		from_landmark.clear();
+		to_landmark.clear();
+		vector<T> nearest(n, INF);
+		int l = first;
+		for (int i = 0; i < k && i < n; i++) {
+			landmarks.push_back(l);
+			from_landmark.push_back(dijkstra_impl<T, Binary_Heap_Queue>(G, l).first);
+			to_landmark.push_back(dijkstra_impl<T, Binary_Heap_Queue>(RG, l).first);
+			int far = -1;
+			for (int v = 0; v < n; v++) {
+				nearest[v] = min(nearest[v], from_landmark.back()[v]);
+				if (nearest[v] != (T)INF && nearest[v] > 0 && (far < 0 || nearest[v] > nearest[far]))
+					far = v;
+			}
+			if (far < 0)
+				break;
+			l = far;
+		}
+	}
+	/**
+	 * @brief ランドマークと三角不等式による v から t までの距離の下界
+	 */
+	T landmark_bound(int v, int t) const {
+		T res = 0;
+		for (int i = 0; i < (int)landmarks.size(); i++) {
+			const vector<T> &f = from_landmark[i], &g = to_landmark[i];
+			if (f[t] != (T)INF && f[v] != (T)INF && f[t] > f[v])
+				res = max(res, f[t] - f[v]);
+			if (g[v] != (T)INF && g[t] != (T)INF && g[v] > g[t])
+				res = max(res, g[v] - g[t]);
+		}
+		return res;
+	}
+	/**
+	 * @brief ALT (ランドマークの下界を使う A* 探索)
+	 * @note 先に build_landmarks を呼ぶ
+	 *
+	 * @param s 始点
+	 * @param t 終点
+	 * @return T s から t への最短距離 (到達できなければ INF)
+	 */
+	T alt(int s, int t) {
+		return astar(s, t, [&](int v) { return landmark_bound(v, t); });
+	}
+
+	/**
+	 * @brief 直前のクエリの最短経路 (到達できなければ空)
+	 *
+	 * @return vector<int> s から t までの頂点の列
+	 */
+	vector<int> get_path() const {
+		vector<int> path;
+		if (meet < 0)
+			return path;
+		for (int v = meet; v != -1; v = prev[0][v])
+			path.push_back(v);
+		reverse(path.begin(), path.end());
+		for (int v = prev[1][meet]; v != -1; v = prev[1][v])
+			path.push_back(v);
+		return path;
+	}
+};
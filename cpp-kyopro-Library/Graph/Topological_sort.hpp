@@ -6,12 +6,14 @@ using namespace std;
 /**
  * @brief トポロジカルソート O(V + E) (E := 辺の本数, V := 頂点の個数)
  * 
+ * @tparam Graph グラフの型 (vector<vector<int>> または CSR_Graph<int>)
  * @param G グラフ
  * @param indegree 入次数
  * @param V 頂点数
  * @return vector<int> トポロジカル順のうち昇順で一番はじめのもの(G が DAG でなければ {-1} を返す)
  */
-vector<int> topological_sort(vector<vector<int>> &G, vector<int> &indegree, int V) {
+template <class Graph>
+vector<int> topological_sort(const Graph &G, vector<int> &indegree, int V) {
 	priority_queue<int, vector<int>, greater<>> Q;
 	vector<bool> seen(V, false);
 	vector<int> order;